@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Pretty-prints IR dumps written by boomerang-cli --dump-ir.
+
+An IR dump contains one hunk per dumped pass, holding only the statements that changed
+since the previous hunk. This script lists the hunks, or reconstructs the full IR
+of the procedure after a hunk.
+"""
+
+import argparse
+import re
+import sys
+
+HUNK_RE = re.compile(r"^@@ (\d+) '(.*)' -(\d+) \+(\d+)$")
+EDIT_RE = re.compile(r"^([+-])(\d+) (.*)$")
+
+
+class Hunk:
+    def __init__(self, pass_num, pass_name):
+        self.pass_num = pass_num
+        self.pass_name = pass_name
+        self.edits = []  # (is_insert, index, line)
+
+
+def read_dump(path):
+    hunks = []
+    with open(path, encoding='utf-8') as f:
+        for line_num, line in enumerate(f, 1):
+            line = line.rstrip('\n')
+            if not line or line.startswith('#'):
+                continue
+
+            match = HUNK_RE.match(line)
+            if match:
+                hunks.append(Hunk(int(match.group(1)), match.group(2)))
+                continue
+
+            match = EDIT_RE.match(line)
+            if not match or not hunks:
+                sys.exit("%s:%d: Malformed line" % (path, line_num))
+
+            hunks[-1].edits.append((match.group(1) == '+', int(match.group(2)), match.group(3)))
+
+    return hunks
+
+
+def apply_hunk(lines, hunk):
+    """Returns the statements after applying hunk to the statements lines."""
+    result = []
+    old_idx = 0
+
+    for is_insert, idx, text in hunk.edits:
+        if is_insert:
+            # copy unchanged statements up to the insertion point
+            while len(result) < idx:
+                result.append(lines[old_idx])
+                old_idx += 1
+            result.append(text)
+        else:
+            result.extend(lines[old_idx:idx])
+            old_idx = idx + 1
+
+    result.extend(lines[old_idx:])
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dump', help="IR dump file (<output>/<proc>.irdump)")
+    parser.add_argument('--at', metavar='PASS', type=int,
+                        help="print the full IR after the hunk of pass number PASS "
+                             "(or the last hunk before it)")
+    parser.add_argument('--last', action='store_true', help="print the full IR after the last hunk")
+    parser.add_argument('--diff', metavar='PASS', type=int,
+                        help="print the changes made by the hunk of pass number PASS")
+    args = parser.parse_args()
+
+    hunks = read_dump(args.dump)
+
+    if args.diff is not None:
+        for hunk in hunks:
+            if hunk.pass_num == args.diff:
+                print("after pass %d '%s':" % (hunk.pass_num, hunk.pass_name))
+                for is_insert, _, text in hunk.edits:
+                    print("%s %s" % ('+' if is_insert else '-', text))
+                return 0
+        sys.exit("No hunk for pass %d" % args.diff)
+
+    elif args.at is not None or args.last:
+        lines = []
+        last = None
+        for hunk in hunks:
+            if args.at is not None and hunk.pass_num > args.at:
+                break
+            lines = apply_hunk(lines, hunk)
+            last = hunk
+
+        if last is None:
+            sys.exit("No hunk before pass %d" % args.at)
+
+        print("after pass %d '%s':" % (last.pass_num, last.pass_name))
+        for line in lines:
+            print(line)
+
+    else:
+        # summary
+        for hunk in hunks:
+            num_inserted = sum(1 for edit in hunk.edits if edit[0])
+            print("%5d %-32s -%-5d +%d" % (hunk.pass_num, hunk.pass_name,
+                                           len(hunk.edits) - num_inserted, num_inserted))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -12,11 +12,16 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/util/CFGDotWriter.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QTextStream>
 
+#include <chrono>
 #include <iostream>
 
 
@@ -51,27 +56,46 @@ static void help()
 "\n"
 "Decoding/decompilation options\n"
 "  --decode-only    : Decode only, do not decompile\n"
+"  --decode-on-demand: Only decode the entry points up front; decode all other procedures\n"
+"                     when they are decompiled (e.g. by 'decompile <proc>' in -i mode)\n"
 "  --ssl <file>     : Use <file> as SSL specification file\n"
 "  -e <addr>        : Decode or decompile the procedure beginning at addr, and callees\n"
 "  -E <addr>        : Equivalent to -nc -e <addr>\n"
+"  --root <proc>    : Only decompile the procedures reachable from <proc> (a name or\n"
+"                     an address) and from the -e entry points. May be repeated\n"
 "  -ic              : Decode through type 0 Indirect Calls\n"
 "  -S <min>         : Stop decompilation after specified number of minutes\n"
+"  --proc-time <s>  : Decompile a procedure with a reduced pipeline once its passes\n"
+"                     took more than <s> seconds\n"
+"  --proc-passes <n>: Decompile a procedure with a reduced pipeline once more than <n>\n"
+"                     passes were executed for it\n"
 "  -t               : Trace (print address of) every instruction decoded\n"
 "  -a               : Assume ABI compliance\n"
+"  --pruned-ssa     : Do not place phi functions for dead registers and flags\n"
+"                     (pruned SSA form)\n"
 "\n"
 "Output\n"
 "  --version        : Print version information and exit\n"
 "  -h, --help       : Show this help and exit\n"
 "  -v               : Verbose decompilation output\n"
 "  --log-level <n>  : Set log verbosity (n=0..5, default 3)\n"
+"  --log-async <p>  : Write the log on a background thread. If the log queue is full,\n"
+"                     wait for the writer (p=block) or discard messages (p=drop)\n"
 "  -o <output_path> : Where to generate output (defaults to ./output/)\n"
 "  -r               : Print RTL for each proc to log before code generation\n"
 "  -gd <dot_file>   : Generate a dotty graph of the program's CFG(s)\n"
 "  -gc              : Generate a call graph to callgraph.dot\n"
 "  -gs              : Generate a symbol file (symbols.h). Implies --decode-only.\n"
+"  --stats-out <f>  : Write time and cumulative peak memory usage of each phase to <f> (JSON)\n"
+"  --profile-out <f>: Write time of each phase, procedure and pass to <f> (JSON)\n"
+"  --trace-out <f>  : Write time of each phase, procedure and pass to <f>\n"
+"                     (Chrome trace event format, e.g. for chrome://tracing)\n"
 "\n"
 "Misc.\n"
 "  -i [<file>]      : Interactive mode; execute commands from <file>, if present\n"
+"  --server         : Server mode; read decompilation jobs from stdin, one JSON object\n"
+"                     per line, e.g. {\"binary\": \"a.exe\", \"output\": \"out/\", \"timeout\": 60}\n"
+"                     -S sets the default timeout of each job\n"
 "  -P <path>        : Path to Boomerang files, defaults to the path to the Boomerang executable\n"
 "  --               : Terminates argument processing\n"
 "\n"
@@ -83,6 +107,10 @@ static void help()
 "  -dp              : Debug Proof Engine\n"
 "  -dt              : Debug Type Analysis\n"
 "  -du              : Debug removal of unused statements etc.\n"
+"  --dump-ir <re>   : Write the IR of all procedures matching the regular expression <re>\n"
+"                     to <output_path>/<proc>.irdump after each pass; only changed\n"
+"                     statements are written (see scripts/print-ir-dump.py)\n"
+"  --dump-passes <re>: Only dump the IR after passes matching <re> (default: all)\n"
 "\n"
 "Restrictions\n"
 "  -nc              : Do not decode callees of functions\n"
@@ -156,6 +184,49 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             Log::getOrCreateLog().setLogLevel((LogLevel)logLevel);
             continue;
         }
+        else if (arg == "--proc-time" || arg == "--proc-passes") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted   = false;
+            const int budget = args[i].toInt(&converted, 0);
+            if (!converted || budget < 0) {
+                std::cerr << "'" << arg.toStdString() << "': Bad argument '"
+                          << args[i].toStdString() << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            if (arg == "--proc-time") {
+                m_project->getSettings()->procTimeBudget = budget;
+            }
+            else {
+                m_project->getSettings()->procPassBudget = budget;
+            }
+
+            continue;
+        }
+        else if (arg == "--log-async") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            if (args[i] == "block") {
+                Log::getOrCreateLog().setAsyncMode(true, LogOverflowPolicy::Block);
+            }
+            else if (args[i] == "drop") {
+                Log::getOrCreateLog().setAsyncMode(true, LogOverflowPolicy::Drop);
+            }
+            else {
+                std::cerr << "'--log-async': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
         else if (arg == "-r") {
             m_project->getSettings()->printRTLs = true;
             continue;
@@ -186,6 +257,23 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             m_project->getSettings()->stopBeforeDecompile = true;
             continue;
         }
+        else if (arg == "--decode-on-demand") {
+            m_project->getSettings()->decodeOnDemand = true;
+            continue;
+        }
+        else if (arg == "--pruned-ssa") {
+            m_project->getSettings()->usePrunedSSA = true;
+            continue;
+        }
+        else if (arg == "--root") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_project->getSettings()->m_rootProcs.push_back(args[i]);
+            continue;
+        }
         else if (arg == "--ssl") {
             if (++i == args.size()) {
                 help();
@@ -224,6 +312,56 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             m_project->getSettings()->setOutputDirectory(wd.path() + "/./output/");
             continue;
         }
+        else if (arg == "--stats-out") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_statsFile = args[i];
+            continue;
+        }
+        else if (arg == "--profile-out") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_profileFile = args[i];
+            m_project->getProfiler()->setEnabled(true);
+            continue;
+        }
+        else if (arg == "--trace-out") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_traceFile = args[i];
+            m_project->getProfiler()->setEnabled(true);
+            continue;
+        }
+        else if (arg == "--dump-ir" || arg == "--dump-passes") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            IRDumper *dumper = m_project->getIRDumper();
+            const bool ok    = (arg == "--dump-ir") ? dumper->setProcFilter(args[i])
+                                                    : dumper->setPassFilter(args[i]);
+            if (!ok) {
+                std::cerr << "'" << arg.toStdString() << "': Bad regular expression '"
+                          << args[i].toStdString() << "'." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
+        else if (arg == "--server") {
+            m_serverMode = true;
+            continue;
+        }
         else if (arg == "-ic") {
             m_project->getSettings()->decodeThruIndCall = true;
             continue;
@@ -435,6 +573,16 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
     if (interactiveMode) {
         return interactiveMain();
     }
+    else if (m_serverMode) {
+        if (binaryPath != "") {
+            // binaries are specified per job
+            help();
+            return 1;
+        }
+
+        // -S is applied to each job instead of the whole server
+        return 0;
+    }
     else if (binaryPath == "") {
         help();
         return 1;
@@ -484,6 +632,48 @@ int CommandlineDriver::interactiveMain()
 }
 
 
+int CommandlineDriver::serverMain()
+{
+    QTextStream strm(stdin);
+    return serverMain(strm, std::cout);
+}
+
+
+int CommandlineDriver::serverMain(QTextStream &jobs, std::ostream &results)
+{
+    // Do not log to stdout; it is reserved for job results.
+    Log::getOrCreateLog().addDefaultLogSinks(
+        m_project->getSettings()->getOutputDirectory().absolutePath(), false);
+    m_project->loadPlugins();
+
+    while (!jobs.atEnd()) {
+        const QString line = jobs.readLine().trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        QJsonParseError parseError;
+        const QJsonDocument jobDoc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
+        QJsonObject result;
+
+        if (parseError.error != QJsonParseError::NoError || !jobDoc.isObject()) {
+            result["status"] = "error";
+            result["error"]  = parseError.error != QJsonParseError::NoError
+                                  ? parseError.errorString()
+                                  : QString("Job is not a JSON object");
+        }
+        else {
+            result = runServerJob(jobDoc.object());
+        }
+
+        results << QJsonDocument(result).toJson(QJsonDocument::Compact).toStdString()
+                << std::endl;
+    }
+
+    return 0;
+}
+
+
 int CommandlineDriver::decompile()
 {
     Log::getOrCreateLog().addDefaultLogSinks(
@@ -493,13 +683,30 @@ int CommandlineDriver::decompile()
     QDir wd       = m_project->getSettings()->getWorkingDirectory();
     QFileInfo inf = QFileInfo(wd.absoluteFilePath(m_pathToBinary));
 
-    return decompile(inf.absoluteFilePath(), inf.baseName());
+    const int ret = decompile(inf.absoluteFilePath(), inf.baseName());
+
+    if (!m_statsFile.isEmpty() && !writePhaseStats(inf.absoluteFilePath(), m_statsFile)) {
+        LOG_ERROR("Could not write statistics to '%1'", m_statsFile);
+    }
+
+    if (!m_profileFile.isEmpty() &&
+        !m_project->getProfiler()->writeJSON(wd.absoluteFilePath(m_profileFile))) {
+        LOG_ERROR("Could not write profile to '%1'", m_profileFile);
+    }
+
+    if (!m_traceFile.isEmpty() &&
+        !m_project->getProfiler()->writeChromeTrace(wd.absoluteFilePath(m_traceFile))) {
+        LOG_ERROR("Could not write trace to '%1'", m_traceFile);
+    }
+
+    return ret;
 }
 
 
 void CommandlineDriver::onCompilationTimeout()
 {
     LOG_WARN("Compilation timed out, Boomerang will now exit");
+    Log::getOrCreateLog().flush();
     exit(1);
 }
 
@@ -559,3 +766,218 @@ int CommandlineDriver::decompile(const QString &fname, const QString &pname)
     LOG_MSG("Completed in %1 hours %2 minutes %3 seconds.", hours, mins, secs);
     return 0;
 }
+
+
+bool CommandlineDriver::writePhaseStats(const QString &binaryPath, const QString &statsPath) const
+{
+    QJsonArray phases;
+    std::chrono::duration<double> totalTime(0);
+
+    for (const PhaseStats &stats : m_project->getPhaseStats()) {
+        const std::chrono::duration<double> phaseTime = stats.time;
+        totalTime += phaseTime;
+
+        QJsonObject phase;
+        phase["name"]              = stats.name;
+        phase["time"]              = phaseTime.count();
+        phase["cumulativePeakRSS"] = static_cast<qint64>(stats.peakMemoryUsage);
+        phase["peakRSSGrowth"]     = static_cast<qint64>(stats.peakMemoryGrowth);
+        phases.append(phase);
+    }
+
+    QJsonObject result;
+    result["binary"]  = binaryPath;
+    result["phases"]  = phases;
+    result["time"]    = totalTime.count();
+    result["peakRSS"] = static_cast<qint64>(Util::getPeakMemoryUsage());
+
+    QFile statsFile(m_project->getSettings()->getWorkingDirectory().absoluteFilePath(statsPath));
+    if (!statsFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
+
+    return statsFile.write(QJsonDocument(result).toJson()) != -1;
+}
+
+
+QJsonObject CommandlineDriver::runServerJob(const QJsonObject &job)
+{
+    QJsonObject result;
+    if (job.contains("id")) {
+        result["id"] = job["id"];
+    }
+
+    const QString binaryPath = job["binary"].toString();
+    if (binaryPath.isEmpty()) {
+        result["status"] = "error";
+        result["error"]  = "No binary file specified";
+        return result;
+    }
+
+    Settings *settings            = m_project->getSettings();
+    const Settings serverSettings = *settings;
+    const LogLevel serverLogLevel = Log::getOrCreateLog().getLogLevel();
+
+    QString error;
+    if (job.contains("output")) {
+        QString outPath = job["output"].toString();
+        if (!outPath.endsWith('/') && !outPath.endsWith('\\')) {
+            outPath += '/';
+        }
+
+        settings->setOutputDirectory(outPath);
+    }
+
+    if (!applyJobSettings(job["settings"].toObject(), error)) {
+        *settings = serverSettings;
+        Log::getOrCreateLog().setLogLevel(serverLogLevel);
+
+        result["status"] = "error";
+        result["error"]  = error;
+        return result;
+    }
+
+    const double timeoutSecs = job.contains("timeout") ? job["timeout"].toDouble()
+                                                       : 60.0 * minsToStopAfter;
+    if (timeoutSecs > 0) {
+        m_project->setDeadline(std::chrono::steady_clock::now() +
+                               std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                   std::chrono::duration<double>(timeoutSecs)));
+    }
+
+    const QFileInfo inf = QFileInfo(settings->getWorkingDirectory().absoluteFilePath(binaryPath));
+    const auto start    = std::chrono::steady_clock::now();
+
+    try {
+        const int ret    = decompile(inf.absoluteFilePath(), inf.baseName());
+        result["status"] = (ret == 0) ? "ok" : "failed";
+    }
+    catch (const DeadlineExpiredError &) {
+        LOG_WARN("Decompilation of '%1' timed out after %2 seconds", binaryPath, timeoutSecs);
+        result["status"] = "timeout";
+    }
+    catch (const std::exception &e) {
+        // Only this job failed; keep serving the next ones.
+        LOG_ERROR("Decompilation of '%1' failed: %2", binaryPath, e.what());
+        result["status"] = "error";
+        result["error"]  = QString(e.what());
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result["time"]   = elapsed.count();
+    result["output"] = settings->getOutputDirectory().absolutePath();
+
+    // The next job starts from scratch, but with warm plugins.
+    m_project->clearDeadline();
+    m_project->unloadBinaryFile();
+    *settings = serverSettings;
+    Log::getOrCreateLog().setLogLevel(serverLogLevel);
+
+    return result;
+}
+
+
+bool CommandlineDriver::applyJobSettings(const QJsonObject &jobSettings, QString &error)
+{
+    static const std::map<QString, bool Settings::*> boolSettings = {
+        { "verboseOutput", &Settings::verboseOutput },
+        { "debugSwitch", &Settings::debugSwitch },
+        { "debugLiveness", &Settings::debugLiveness },
+        { "debugTA", &Settings::debugTA },
+        { "debugDecoder", &Settings::debugDecoder },
+        { "debugProof", &Settings::debugProof },
+        { "debugUnused", &Settings::debugUnused },
+        { "debugGen", &Settings::debugGen },
+        { "printRTLs", &Settings::printRTLs },
+        { "removeNull", &Settings::removeNull },
+        { "useLocals", &Settings::useLocals },
+        { "removeLabels", &Settings::removeLabels },
+        { "useDataflow", &Settings::useDataflow },
+        { "usePrunedSSA", &Settings::usePrunedSSA },
+        { "stopBeforeDecompile", &Settings::stopBeforeDecompile },
+        { "traceDecoder", &Settings::traceDecoder },
+        { "usePromotion", &Settings::usePromotion },
+        { "nameParameters", &Settings::nameParameters },
+        { "decodeMain", &Settings::decodeMain },
+        { "removeReturns", &Settings::removeReturns },
+        { "decodeThruIndCall", &Settings::decodeThruIndCall },
+        { "decodeChildren", &Settings::decodeChildren },
+        { "useTypeAnalysis", &Settings::useTypeAnalysis },
+        { "useGlobals", &Settings::useGlobals },
+        { "assumeABI", &Settings::assumeABI },
+    };
+
+    static const std::map<QString, int Settings::*> intSettings = {
+        { "propMaxDepth", &Settings::propMaxDepth },
+        { "procTimeBudget", &Settings::procTimeBudget },
+        { "procPassBudget", &Settings::procPassBudget },
+    };
+
+    Settings *settings = m_project->getSettings();
+
+    for (auto it = jobSettings.begin(); it != jobSettings.end(); ++it) {
+        const QString &key = it.key();
+        const auto boolIt  = boolSettings.find(key);
+
+        if (boolIt != boolSettings.end()) {
+            if (!it.value().isBool()) {
+                error = QString("Setting '%1' must be a boolean").arg(key);
+                return false;
+            }
+
+            settings->*(boolIt->second) = it.value().toBool();
+        }
+        else if (intSettings.find(key) != intSettings.end()) {
+            if (!it.value().isDouble()) {
+                error = QString("Setting '%1' must be a number").arg(key);
+                return false;
+            }
+
+            settings->*(intSettings.at(key)) = it.value().toInt();
+        }
+        else if (key == "logLevel") {
+            // same as --log-level
+            const int logLevel = it.value().toInt(-1);
+
+            if (!it.value().isDouble() || logLevel < (int)LogLevel::Fatal ||
+                logLevel > (int)LogLevel::Verbose2) {
+                error = QString("Setting '%1' must be a log level (0..5)").arg(key);
+                return false;
+            }
+
+            Log::getOrCreateLog().setLogLevel((LogLevel)logLevel);
+        }
+        else if (key == "entryPoints") {
+            // same as -e
+            for (const QJsonValue &entry : it.value().toArray()) {
+                bool converted     = false;
+                const Address addr = Address(entry.toString().toLongLong(&converted, 0));
+
+                if (!converted) {
+                    error = QString("Bad entry point address '%1'").arg(entry.toString());
+                    return false;
+                }
+
+                settings->m_entryPoints.push_back(addr);
+                settings->decodeMain = false;
+            }
+        }
+        else if (key == "symbolFiles") {
+            for (const QJsonValue &symbolFile : it.value().toArray()) {
+                settings->m_symbolFiles.push_back(symbolFile.toString());
+            }
+        }
+        else if (key == "rootProcs") {
+            // same as --root
+            for (const QJsonValue &rootProc : it.value().toArray()) {
+                settings->m_rootProcs.push_back(rootProc.toString());
+            }
+        }
+        else {
+            error = QString("Unknown setting '%1'").arg(key);
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -14,9 +14,15 @@
 
 #include "boomerang/core/Project.h"
 
+#include <QJsonObject>
 #include <QObject>
 #include <QTimer>
 
+#include <iosfwd>
+
+
+class QTextStream;
+
 
 class CommandlineDriver : public QObject
 {
@@ -49,6 +55,26 @@ public:
      */
     int interactiveMain();
 
+    /**
+     * Keeps plugins, SSL files and library signatures loaded and decompiles jobs
+     * read from stdin, one JSON object per line. A fresh Prog is created for each job.
+     * The result of each job is written to stdout as a single line of JSON.
+     * \ref applyCommandline must be called first.
+     *
+     * \retval 0 stdin was closed.
+     */
+    int serverMain();
+
+    /**
+     * \copydoc serverMain()
+     * Jobs are read from \p jobs instead of stdin, and results are written to \p results.
+     * \retval 0 \p jobs was exhausted.
+     */
+    int serverMain(QTextStream &jobs, std::ostream &results);
+
+    /// \returns true if --server was given on the command line.
+    bool isServerMode() const { return m_serverMode; }
+
     const Project *getProject() const { return m_project.get(); }
 
 private:
@@ -70,6 +96,29 @@ private:
      */
     int decompile(const QString &fname, const QString &pname);
 
+    /**
+     * Run a single server job, i.e. load, decode, decompile and generate code
+     * for the binary file described by \p job.
+     * Settings and the log level changed by the job are reverted afterwards.
+     *
+     * \returns the result of the job, to be reported to the client.
+     */
+    QJsonObject runServerJob(const QJsonObject &job);
+
+    /**
+     * Apply the "settings" object of a server job to the Settings.
+     * \returns false if \p jobSettings contains an unknown or malformed setting,
+     * with \p error set to a description of the problem.
+     */
+    bool applyJobSettings(const QJsonObject &jobSettings, QString &error);
+
+    /**
+     * Write the wall time and peak memory usage of each phase of the decompilation
+     * of \p binaryPath to the file \p statsPath as JSON.
+     * \returns true on success.
+     */
+    bool writePhaseStats(const QString &binaryPath, const QString &statsPath) const;
+
 public slots:
     void onCompilationTimeout();
 
@@ -79,5 +128,9 @@ private:
 
     QTimer m_kill_timer;
     int minsToStopAfter = 0;
+    bool m_serverMode   = false;
     QString m_pathToBinary;
+    QString m_statsFile;   ///< Phase statistics are written to this file (--stats-out)
+    QString m_profileFile; ///< Profiler results are written to this file (--profile-out)
+    QString m_traceFile;   ///< Profiler results are written to this file (--trace-out)
 };
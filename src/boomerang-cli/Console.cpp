@@ -12,6 +12,9 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ifc/ICodeGenerator.h"
@@ -234,6 +237,16 @@ CommandStatus Console::handleDecompile(const QStringList &args)
         for (const QString &procName : args) {
             Function *proc = prog->getFunctionByName(procName);
 
+            if (proc == nullptr) {
+                // Procedures are not created before they are decoded when decoding on demand
+                const BinarySymbol *sym = prog->getBinaryFile()->getSymbols()->findSymbolByName(
+                    procName);
+
+                if (sym && !sym->isImportedFunction()) {
+                    proc = prog->getOrCreateFunction(sym->getLocation());
+                }
+            }
+
             if (proc == nullptr) {
                 std::cerr << "Cannot find function '" << procName.toStdString() << "'\n";
                 return CommandStatus::Failure;
@@ -251,7 +264,11 @@ CommandStatus Console::handleDecompile(const QStringList &args)
         }
 
         for (UserProc *userProc : procSet) {
-            userProc->decompileRecursive();
+            if (!m_project->decompileProc(userProc)) {
+                std::cerr << "Failed to decompile function '" << userProc->getName().toStdString()
+                          << "'\n";
+                return CommandStatus::Failure;
+            }
         }
 
         return CommandStatus::Success;
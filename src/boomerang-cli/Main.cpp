@@ -10,6 +10,7 @@
 
 
 #include "boomerang-cli/CommandlineDriver.h"
+#include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
 #include <QStringList>
@@ -20,10 +21,12 @@ int main(int argc, char *argv[])
     QCoreApplication app(argc, argv);
     CommandlineDriver driver;
 
-    const int applyResult = driver.applyCommandline(app.arguments());
-    if (applyResult != 0) {
-        return applyResult;
+    int result = driver.applyCommandline(app.arguments());
+    if (result == 0) {
+        result = driver.isServerMode() ? driver.serverMain() : driver.decompile();
     }
 
-    return driver.decompile();
+    // Write all queued log messages before the log writer thread is killed.
+    Log::getOrCreateLog().setAsyncMode(false);
+    return result;
 }
@@ -129,6 +129,21 @@ void Decompiler::decompile()
 }
 
 
+void Decompiler::decompileProc(const QString &name)
+{
+    Function *function = m_project.getProg() ? m_project.getProg()->getFunctionByName(name)
+                                             : nullptr;
+
+    if (!function || function->isLib()) {
+        return;
+    }
+
+    if (m_project.decompileProc(static_cast<UserProc *>(function))) {
+        emit procDecompiled(name);
+    }
+}
+
+
 void Decompiler::moduleAndChildrenUpdated(Module *root)
 {
     emit moduleCreated(root->getName());
@@ -59,6 +59,7 @@ signals: // Decompiler -> ui
 
     void procDiscovered(const QString &callerName, const QString &procName);
     void procDecompileStarted(const QString &procName);
+    void procDecompiled(const QString &procName);
 
     void userProcCreated(const QString &name, Address entryAddr);
     void libProcCreated(const QString &name, const QString &params);
@@ -77,6 +78,7 @@ public slots: // ui -> Decompiler
     void loadInputFile(const QString &inputFile, const QString &outputPath);
     void decode();
     void decompile();
+    void decompileProc(const QString &name);
     void generateCode();
 
     void stopWaiting();
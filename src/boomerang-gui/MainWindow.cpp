@@ -15,6 +15,7 @@
 #include "boomerang-gui/ui_About.h"
 #include "boomerang-gui/ui_MainWindow.h"
 
+#include "boomerang/core/Settings.h"
 #include "boomerang/ifc/ITypeRecovery.h"
 
 #include <QDesktopServices>
@@ -62,6 +63,7 @@ MainWindow::MainWindow(QWidget *_parent)
     connect(m_decompiler, &Decompiler::userProcRemoved, this, &MainWindow::showRemoveUserProc);
     connect(m_decompiler, &Decompiler::libProcRemoved, this, &MainWindow::showRemoveLibProc);
     connect(m_decompiler, &Decompiler::sectionAdded, this, &MainWindow::showNewSection);
+    connect(m_decompiler, &Decompiler::procDecompiled, this, &MainWindow::showRTLEditor);
 
     connect(ui->btnToLoad, &QPushButton::clicked, this, [=]() {
         m_decompiler->loadInputFile(ui->cbInputFile->currentText(),
@@ -77,6 +79,7 @@ MainWindow::MainWindow(QWidget *_parent)
             SLOT(addEntryPoint(Address, const QString &)));
     connect(this, SIGNAL(entryPointRemoved(Address)), m_decompiler,
             SLOT(removeEntryPoint(Address)));
+    connect(this, &MainWindow::procDecompileRequested, m_decompiler, &Decompiler::decompileProc);
 
     ui->tblUserProcs->horizontalHeader()->disconnect(SIGNAL(sectionClicked(int)));
     connect(ui->tblUserProcs->horizontalHeader(), &QHeaderView::sectionClicked, this,
@@ -704,7 +707,16 @@ void MainWindow::showRTLEditor(const QString &name)
 void MainWindow::on_tblUserProcs_cellDoubleClicked(int row, int column)
 {
     Q_UNUSED(column);
-    showRTLEditor(ui->tblUserProcs->item(row, 1)->text());
+    const QString name = ui->tblUserProcs->item(row, 1)->text();
+
+    showRTLEditor(name);
+
+    // Decompiling a procedure on demand takes it out of SSA form, which prevents
+    // whole-program analyses on it later. Only do this when decoding on demand.
+    if (m_decompiler->getProject()->getSettings()->decodeOnDemand) {
+        // The editor is updated once the procedure has been decompiled.
+        emit procDecompileRequested(name);
+    }
 }
 
 
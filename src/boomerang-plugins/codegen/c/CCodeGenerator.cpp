@@ -36,7 +36,13 @@
 #include "boomerang/util/ByteUtil.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
+#include <vector>
 
 
 // index of the "then" branch of conditional jumps
@@ -46,6 +52,35 @@
 #define BELSE 1
 
 
+/// Runs a function on a thread pool and reports its completion through a future.
+class CodeGenTask : public QRunnable
+{
+public:
+    explicit CodeGenTask(std::function<void()> func)
+        : m_func(std::move(func))
+    {
+    }
+
+public:
+    std::future<void> getFuture() { return m_promise.get_future(); }
+
+    void run() override
+    {
+        try {
+            m_func();
+            m_promise.set_value();
+        }
+        catch (...) {
+            m_promise.set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::function<void()> m_func;
+    std::promise<void> m_promise;
+};
+
+
 CCodeGenerator::CCodeGenerator(Project *project)
     : ICodeGenerator(project)
 {
@@ -58,6 +93,14 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
     const bool generate_all = cluster == nullptr || cluster == prog->getRootModule();
     bool all_procedures     = (proc == nullptr);
 
+    // Do not keep files open (or Module pointers around) after the Prog is gone,
+    // even if code generation is aborted by an exception.
+    struct WriterCloser
+    {
+        CodeWriter &writer;
+        ~WriterCloser() { writer.closeAll(); }
+    } closer{ m_writer };
+
     // First declare prototypes
     for (const auto &module : prog->getModuleList()) {
         for (Function *func : *module) {
@@ -90,6 +133,14 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
         appendLine(""); // Separate prototype(s) from first proc
         print(prog->getRootModule());
     }
+    else {
+        // The prototypes precede the code of the cluster
+        print(cluster);
+    }
+
+    // Split code generation into one job per procedure.
+    // The code of all jobs is written in order of the jobs, so the output is deterministic.
+    std::vector<CodeGenJob> jobs;
 
     for (const auto &module : prog->getModuleList()) {
         if (!generate_all && (module.get() != cluster)) {
@@ -111,9 +162,45 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
                 continue;
             }
 
-            generateCode(_proc);
-            print(module.get());
+            jobs.emplace_back();
+            jobs.back().module = module.get();
+            jobs.back().proc   = _proc;
+        }
+    }
+
+    // The jobs run on a thread pool. To bound the memory used by code that is not written yet,
+    // only a few jobs per thread are started ahead of the oldest unfinished job.
+    QThreadPool pool;
+    const std::size_t maxPendingJobs = 2 *
+                                       static_cast<std::size_t>(std::max(1, pool.maxThreadCount()));
+
+    // Do not let running jobs access the jobs or the IR after an exception.
+    struct PoolWaiter
+    {
+        QThreadPool &pool;
+        ~PoolWaiter()
+        {
+            pool.clear();
+            pool.waitForDone();
         }
+    } waiter{ pool };
+
+    std::size_t numStarted = 0;
+
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        for (; numStarted < jobs.size() && numStarted < i + maxPendingJobs; ++numStarted) {
+            prog->getProject()->checkDeadline();
+
+            CodeGenJob &job = jobs[numStarted];
+            prepareJob(job);
+
+            CodeGenTask *task = new CodeGenTask([this, &job]() { runJob(job); });
+            job.done          = task->getFuture();
+            pool.start(task); // the pool deletes the task
+        }
+
+        jobs[i].done.get(); // rethrows exceptions of the job
+        finishJob(jobs[i]);
     }
 }
 
@@ -137,7 +224,6 @@ void CCodeGenerator::addAssignmentStatement(const std::shared_ptr<const Assign>
 
     QString tgt;
     OStream ost(&tgt);
-    indent(ost, m_indent);
 
     SharedType asgnType = asgn->getType();
     SharedExp lhs       = asgn->getLeft();
@@ -176,7 +262,7 @@ void CCodeGenerator::addAssignmentStatement(const std::shared_ptr<const Assign>
 
         appendExp(ost, rhs, OpPrec::Assign);
         ost << ";";
-        appendLine(tgt);
+        appendLine(tgt, m_indent);
         return;
     }
     else {
@@ -234,7 +320,7 @@ void CCodeGenerator::addAssignmentStatement(const std::shared_ptr<const Assign>
         ost << ";";
     }
 
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -244,7 +330,6 @@ void CCodeGenerator::addCallStatement(const Function *proc, const QString &name,
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
 
     if (!results.empty()) {
         // FIXME: Needs changing if more than one real result (return a struct)
@@ -308,7 +393,7 @@ void CCodeGenerator::addCallStatement(const Function *proc, const QString &name,
         s << " */";
     }
 
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -319,7 +404,6 @@ void CCodeGenerator::addIndCallStatement(const SharedExp &exp, const StatementLi
     //    FIXME: Need to use 'results', since we can infer some defines...
     QString tgt;
     OStream s(&tgt);
-    indent(s, m_indent);
     s << "(*";
     appendExp(s, exp, OpPrec::None);
     s << ")(";
@@ -335,7 +419,7 @@ void CCodeGenerator::addIndCallStatement(const SharedExp &exp, const StatementLi
     }
 
     s << arg_strings.join(", ") << ");";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -346,7 +430,6 @@ void CCodeGenerator::addReturnStatement(const StatementList *rets)
     // removed here
     QString tgt;
     OStream ost(&tgt);
-    indent(ost, m_indent);
     ost << "return";
     size_t n = rets->size();
 
@@ -383,27 +466,26 @@ void CCodeGenerator::addReturnStatement(const StatementList *rets)
         }
     }
 
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
 void CCodeGenerator::removeUnusedLabels()
 {
-    for (QStringList::iterator it = m_lines.begin(); it != m_lines.end();) {
-        if (it->startsWith("bb0x") && it->contains(':')) {
-            QStringRef bbAddrString = it->midRef(4, it->indexOf(':') - 4);
-            bool ok                 = false;
-            Address bbAddr(bbAddrString.toLongLong(&ok, 16));
-            assert(ok);
-
-            if (m_usedLabels.find(bbAddr.value()) == m_usedLabels.end()) {
-                it = m_lines.erase(it);
-                continue;
-            }
+    m_code.removeLines([this](std::string_view line) {
+        const std::size_t colonPos = line.find(':');
+        if (line.substr(0, 4) != "bb0x" || colonPos == std::string_view::npos) {
+            return false;
         }
 
-        ++it;
-    }
+        const QByteArray bbAddrString = QByteArray::fromRawData(line.data() + 4,
+                                                                static_cast<int>(colonPos - 4));
+        bool ok = false;
+        Address bbAddr(bbAddrString.toLongLong(&ok, 16));
+        assert(ok);
+
+        return m_usedLabels.find(bbAddr.value()) == m_usedLabels.end();
+    });
 }
 
 
@@ -414,17 +496,16 @@ void CCodeGenerator::addPrototype(UserProc *proc)
 }
 
 
-void CCodeGenerator::generateCode(UserProc *proc)
+bool CCodeGenerator::generateCode(UserProc *proc)
 {
-    m_lines.clear();
+    m_code.clear();
     m_proc = proc;
 
     if (!proc->getCFG() || !proc->getEntryFragment()) {
-        return;
+        return false;
     }
 
     m_analyzer.structureCFG(proc->getCFG());
-    PassManager::get()->executePass(PassID::UnusedLocalRemoval, proc);
 
     // Note: don't try to remove unused statements here; that requires the
     // RefExps, which are all gone now (transformed out of SSA form)!
@@ -463,7 +544,7 @@ void CCodeGenerator::generateCode(UserProc *proc)
         removeUnusedLabels();
     }
 
-    proc->setStatus(ProcStatus::CodegenDone);
+    return true;
 }
 
 
@@ -579,13 +660,8 @@ void CCodeGenerator::addFunctionSignature(UserProc *proc, bool open)
 
         if (ty->isPointer() && ty->as<PointerType>()->getPointsTo()->isArray()) {
             // C does this by default when you pass an array, i.e. you pass &array meaning array
-            // Replace all m[param] with foo, param with foo, then foo with param
+            // (see replaceArrayParameters)
             ty = ty->as<PointerType>()->getPointsTo();
-
-            SharedExp foo = Const::get("foo123412341234");
-            m_proc->searchAndReplace(*Location::memOf(left, nullptr), foo);
-            m_proc->searchAndReplace(*left, foo);
-            m_proc->searchAndReplace(*foo, left);
         }
 
         appendTypeIdent(s, ty, name);
@@ -610,11 +686,10 @@ void CCodeGenerator::addPretestedLoopHeader(const SharedExp &cond)
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "while (";
     appendExp(s, cond, OpPrec::None);
     s << ") {";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -627,9 +702,8 @@ void CCodeGenerator::addPretestedLoopEnd()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "}";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -638,9 +712,8 @@ void CCodeGenerator::addEndlessLoopHeader()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "for(;;) {";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -652,9 +725,8 @@ void CCodeGenerator::addEndlessLoopEnd()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "}";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -663,9 +735,8 @@ void CCodeGenerator::addPostTestedLoopHeader()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "do {";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
     m_indent++;
 }
 
@@ -677,11 +748,10 @@ void CCodeGenerator::addPostTestedLoopEnd(const SharedConstExp &cond)
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "} while (";
     appendExp(s, cond, OpPrec::None);
     s << ");";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -690,11 +760,10 @@ void CCodeGenerator::addCaseCondHeader(const SharedConstExp &cond)
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "switch(";
     appendExp(s, cond, OpPrec::None);
     s << ") {";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -707,11 +776,10 @@ void CCodeGenerator::addCaseCondOption(const SharedConstExp &opt)
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "case ";
     appendExp(s, opt, OpPrec::None);
     s << ":";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -722,9 +790,8 @@ void CCodeGenerator::addCaseCondOptionEnd()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "break;";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -734,9 +801,8 @@ void CCodeGenerator::addCaseCondElse()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "default:";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -749,9 +815,8 @@ void CCodeGenerator::addCaseCondEnd()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "}";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -760,11 +825,10 @@ void CCodeGenerator::addIfCondHeader(const SharedConstExp &cond)
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "if (";
     appendExp(s, cond, OpPrec::None);
     s << ") {";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -777,9 +841,8 @@ void CCodeGenerator::addIfCondEnd()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "}";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -788,11 +851,10 @@ void CCodeGenerator::addIfElseCondHeader(const SharedConstExp &cond)
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "if (";
     appendExp(s, cond, OpPrec::None);
     s << ") {";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -805,14 +867,12 @@ void CCodeGenerator::addIfElseCondOption()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "}";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     tgt = "";
-    indent(s, m_indent);
     s << "else {";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 
     m_indent++;
 }
@@ -825,9 +885,8 @@ void CCodeGenerator::addIfElseCondEnd()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "}";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -836,9 +895,8 @@ void CCodeGenerator::addGoto(const IRFragment *frag)
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "goto bb0x" << QString::number(frag->getLowAddr().value(), 16) << ";";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
     m_usedLabels.insert(frag->getLowAddr().value());
 }
 
@@ -848,9 +906,8 @@ void CCodeGenerator::addContinue()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "continue;";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -859,9 +916,8 @@ void CCodeGenerator::addBreak()
     QString tgt;
     OStream s(&tgt);
 
-    indent(s, m_indent);
     s << "break;";
-    appendLine(tgt);
+    appendLine(tgt, m_indent);
 }
 
 
@@ -882,6 +938,11 @@ void CCodeGenerator::addProcStart(UserProc *proc)
 
     s << "/** address: " << proc->getEntryAddress() << " */";
     appendLine(tgt);
+
+    if (proc->isDegraded()) {
+        appendLine("/** degraded: decompilation budget exceeded */");
+    }
+
     addFunctionSignature(proc, true);
 }
 
@@ -899,7 +960,6 @@ void CCodeGenerator::addLocal(const QString &name, SharedType type, bool last)
     QString tgt;
     OStream ost(&tgt);
 
-    indent(ost, 1);
     appendTypeIdent(ost, type, name);
     SharedConstExp e = m_proc->expFromSymbol(name);
 
@@ -919,7 +979,7 @@ void CCodeGenerator::addLocal(const QString &name, SharedType type, bool last)
         ost << ";";
     }
 
-    appendLine(tgt);
+    appendLine(tgt, 1);
 
     if (last) {
         appendLine("");
@@ -2667,22 +2727,75 @@ void CCodeGenerator::writeFragment(const IRFragment *frag)
 }
 
 
-void CCodeGenerator::print(const Module *module)
+void CCodeGenerator::prepareJob(CodeGenJob &job)
 {
-    m_writer.writeCode(module, m_lines);
-    m_lines.clear();
+    UserProc *proc = job.proc;
+
+    if (!proc->getCFG() || !proc->getEntryFragment()) {
+        return;
+    }
+
+    replaceArrayParameters(proc);
+    PassManager::get()->executePass(PassID::UnusedLocalRemoval, proc);
 }
 
 
-void CCodeGenerator::indent(OStream &str, int indLevel)
+void CCodeGenerator::runJob(CodeGenJob &job) const
+{
+    job.startTime = std::chrono::steady_clock::now();
+
+    CCodeGenerator generator(job.proc->getProg()->getProject());
+    job.hasCode = generator.generateCode(job.proc);
+    job.code    = std::move(generator.m_code);
+
+    job.endTime = std::chrono::steady_clock::now();
+}
+
+
+void CCodeGenerator::finishJob(CodeGenJob &job)
+{
+    m_writer.writeCode(job.module, job.code);
+    job.code.clear(); // do not keep the code of all procedures in memory
+
+    if (job.hasCode) {
+        job.proc->setStatus(ProcStatus::CodegenDone);
+    }
+
+    // The profiler is not thread safe, so the job is only recorded now.
+    Profiler *profiler = job.proc->getProg()->getProject()->getProfiler();
+    profiler->addScope(ProfileCategory::Proc, "generateCode", job.proc, job.startTime,
+                       job.endTime);
+}
+
+
+void CCodeGenerator::replaceArrayParameters(UserProc *proc)
+{
+    for (const SharedStmt &parameter : proc->getParameters()) {
+        std::shared_ptr<Assignment> as = parameter->as<Assignment>();
+        SharedExp left                 = as->getLeft();
+        SharedType ty                  = as->getType();
+
+        if (ty && ty->isPointer() && ty->as<PointerType>()->getPointsTo()->isArray()) {
+            // Replace all m[param] with foo, param with foo, then foo with param
+            SharedExp foo = Const::get("foo123412341234");
+            proc->searchAndReplace(*Location::memOf(left, nullptr), foo);
+            proc->searchAndReplace(*left, foo);
+            proc->searchAndReplace(*foo, left);
+        }
+    }
+}
+
+
+void CCodeGenerator::print(const Module *module)
 {
-    str << QString(4 * indLevel, ' ');
+    m_writer.writeCode(module, m_code);
+    m_code.clear();
 }
 
 
-void CCodeGenerator::appendLine(const QString &s)
+void CCodeGenerator::appendLine(const QString &s, int indLevel)
 {
-    m_lines.push_back(s);
+    m_code.appendLine(s, indLevel);
 }
 
 
@@ -10,6 +10,7 @@
 #pragma once
 
 
+#include "CodeBuffer.h"
 #include "CodeWriter.h"
 #include "ControlFlowAnalyzer.h"
 
@@ -21,6 +22,8 @@
 
 #include <QStringList>
 
+#include <chrono>
+#include <future>
 #include <list>
 #include <map>
 #include <unordered_set>
@@ -138,7 +141,9 @@ private:
     void addPrototype(UserProc *proc);
 
     /// Generate code for a single procedure.
-    void generateCode(UserProc *proc);
+    /// Does not modify the IR; the procedure must have been prepared by \ref prepareJob.
+    /// \returns false if \p proc has no code.
+    bool generateCode(UserProc *proc);
 
     /// Generate global variables from data sections.
     void generateDataSectionCode(const BinaryImage *image, QString sectionName,
@@ -320,14 +325,42 @@ private:
     computeOptimalCaseOrdering(const IRFragment *caseHead, const SwitchInfo *switchInfo);
 
 private:
-    void print(const Module *module);
+    /// An independent unit of code generation: The code of a single procedure.
+    struct CodeGenJob
+    {
+        const Module *module = nullptr; ///< The module the code is written to
+        UserProc *proc       = nullptr;
+        CodeBuffer code;                ///< The generated code of \ref proc
+        bool hasCode = false;           ///< False if \ref proc has no code to generate
+
+        std::future<void> done; ///< Ready when the job has run on the thread pool
+        std::chrono::steady_clock::time_point startTime;
+        std::chrono::steady_clock::time_point endTime;
+    };
+
+    /// Make the changes to the IR of the procedure of \p job that code generation needs.
+    /// Must be called on the thread that owns the Prog, since passes are not thread safe.
+    void prepareJob(CodeGenJob &job);
+
+    /// Generate the code for the procedure of \p job into the buffer of \p job.
+    /// Each job uses its own generator state and does not modify the IR,
+    /// so different jobs can run concurrently on a thread pool.
+    void runJob(CodeGenJob &job) const;
+
+    /// Write the code of \p job to its module and release the code buffer.
+    /// Jobs must be finished in order to keep the output deterministic.
+    void finishJob(CodeGenJob &job);
+
+    /// Replace array parameters passed by pointer (m[param]) by the parameter itself,
+    /// since C passes arrays by reference.
+    void replaceArrayParameters(UserProc *proc);
 
-    /// Output 4 * \p indLevel spaces to \p str
-    void indent(OStream &str, int indLevel);
+    void print(const Module *module);
 
     /// Private helper functions, to reduce redundant code, and
     /// have a single place to put a breakpoint on.
-    void appendLine(const QString &s);
+    /// The line is indented by 4 * \p indLevel spaces.
+    void appendLine(const QString &s, int indLevel = 0);
 
 private:
     /// Current indentation depth
@@ -341,5 +374,5 @@ private:
     ControlFlowAnalyzer m_analyzer;
 
     CodeWriter m_writer;
-    QStringList m_lines; ///< The generated code.
+    CodeBuffer m_code; ///< The generated code.
 };
@@ -0,0 +1,114 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CodeBuffer.h"
+
+#include <QIODevice>
+
+#include <algorithm>
+#include <cstring>
+
+
+/// Minimum size of a chunk (in bytes)
+static constexpr const std::size_t CHUNK_SIZE = 1 << 16;
+
+
+void CodeBuffer::appendLine(const QString &line, int indLevel)
+{
+    const std::size_t indentLen = 4 * static_cast<std::size_t>(std::max(indLevel, 0));
+    const std::size_t numChars  = static_cast<std::size_t>(line.size());
+
+    // A UTF-16 code unit takes at most 3 bytes in UTF-8
+    Chunk &chunk = reserve(indentLen + 3 * numChars + 1);
+    char *dest   = chunk.data.get() + chunk.size;
+
+    std::memset(dest, ' ', indentLen);
+    std::size_t lineLen = indentLen;
+
+    // Generated code is mostly ASCII; copy it without converting the whole line.
+    const QChar *src = line.constData();
+    std::size_t i    = 0;
+
+    for (; i < numChars && src[i].unicode() < 0x80; ++i) {
+        dest[lineLen++] = static_cast<char>(src[i].unicode());
+    }
+
+    if (i < numChars) {
+        const QByteArray rest = line.midRef(static_cast<int>(i)).toUtf8();
+        std::memcpy(dest + lineLen, rest.constData(), static_cast<std::size_t>(rest.size()));
+        lineLen += static_cast<std::size_t>(rest.size());
+    }
+
+    dest[lineLen] = '\n';
+
+    m_lines.push_back({ m_chunks.size() - 1, chunk.size, lineLen });
+    chunk.size += lineLen + 1;
+}
+
+
+void CodeBuffer::removeLines(const std::function<bool(std::string_view)> &pred)
+{
+    m_lines.erase(std::remove_if(m_lines.begin(), m_lines.end(),
+                                 [this, &pred](const LineRef &line) {
+                                     return pred(getLineView(line));
+                                 }),
+                  m_lines.end());
+}
+
+
+void CodeBuffer::clear()
+{
+    m_chunks.clear();
+    m_lines.clear();
+}
+
+
+bool CodeBuffer::writeTo(QIODevice &dev) const
+{
+    // Write runs of lines that are stored contiguously
+    const char *runStart = nullptr;
+    std::size_t runSize  = 0;
+
+    for (const LineRef &line : m_lines) {
+        const char *lineStart = m_chunks[line.chunk].data.get() + line.offset;
+
+        if (runStart && runStart + runSize == lineStart) {
+            runSize += line.size + 1;
+            continue;
+        }
+
+        if (runStart && dev.write(runStart, runSize) != static_cast<qint64>(runSize)) {
+            return false;
+        }
+
+        runStart = lineStart;
+        runSize  = line.size + 1;
+    }
+
+    return !runStart || dev.write(runStart, runSize) == static_cast<qint64>(runSize);
+}
+
+
+std::string_view CodeBuffer::getLineView(const LineRef &line) const
+{
+    return std::string_view(m_chunks[line.chunk].data.get() + line.offset, line.size);
+}
+
+
+CodeBuffer::Chunk &CodeBuffer::reserve(std::size_t size)
+{
+    if (m_chunks.empty() || m_chunks.back().size + size > m_chunks.back().capacity) {
+        Chunk chunk;
+        chunk.capacity = std::max(CHUNK_SIZE, size);
+        chunk.data.reset(new char[chunk.capacity]);
+        m_chunks.push_back(std::move(chunk));
+    }
+
+    return m_chunks.back();
+}
@@ -0,0 +1,89 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QString>
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+class QIODevice;
+
+
+/**
+ * Stores generated code as UTF-8 encoded lines in large chunks of memory.
+ * Lines are never split across chunks, and each line is terminated by a newline,
+ * so consecutive lines can be written to the output file without copying them again.
+ */
+class BOOMERANG_PLUGIN_API CodeBuffer
+{
+public:
+    CodeBuffer() = default;
+    CodeBuffer(const CodeBuffer &) = delete;
+    CodeBuffer(CodeBuffer &&)      = default;
+
+    ~CodeBuffer() = default;
+
+    CodeBuffer &operator=(const CodeBuffer &) = delete;
+    CodeBuffer &operator=(CodeBuffer &&) = default;
+
+public:
+    bool isEmpty() const { return m_lines.empty(); }
+    std::size_t getNumLines() const { return m_lines.size(); }
+
+    /**
+     * Append a line (without trailing newline), indented by \p indLevel levels of 4 spaces.
+     * The line is encoded into the last chunk directly.
+     */
+    void appendLine(const QString &line, int indLevel = 0);
+
+    /// Remove all lines (without trailing newline) for which \p pred returns true.
+    void removeLines(const std::function<bool(std::string_view)> &pred);
+
+    /// Remove all lines and release the memory.
+    void clear();
+
+    /**
+     * Write all lines (including the trailing newlines) to \p dev.
+     * Consecutive lines in the same chunk are written at once.
+     * \returns false if the data could not be written
+     */
+    bool writeTo(QIODevice &dev) const;
+
+private:
+    struct LineRef
+    {
+        std::size_t chunk;  ///< Index of the chunk containing the line
+        std::size_t offset; ///< Offset of the line inside the chunk
+        std::size_t size;   ///< Size of the line, excluding the newline
+    };
+
+    struct Chunk
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t capacity = 0;
+        std::size_t size     = 0;
+    };
+
+    std::string_view getLineView(const LineRef &line) const;
+
+    /// \returns a chunk with room for at least \p size bytes after its current end.
+    Chunk &reserve(std::size_t size);
+
+private:
+    std::vector<Chunk> m_chunks;
+    std::vector<LineRef> m_lines;
+};
@@ -9,6 +9,8 @@
 #pragma endregion License
 #include "CodeWriter.h"
 
+#include "CodeBuffer.h"
+
 #include "boomerang/db/module/Module.h"
 
 #include <cassert>
@@ -17,9 +19,9 @@
 
 CodeWriter::WriteDest::WriteDest(const QString &outFileName)
     : m_outFile(outFileName)
-    , m_os(&m_outFile)
 {
-    if (!m_outFile.open(QFile::WriteOnly | QFile::Text)) {
+    // The code is already buffered by CodeBuffer, so write it directly to the file
+    if (!m_outFile.open(QFile::WriteOnly | QFile::Text | QFile::Unbuffered)) {
         throw std::runtime_error("Could not open file!");
     }
 }
@@ -27,17 +29,27 @@ CodeWriter::WriteDest::WriteDest(const QString &outFileName)
 
 CodeWriter::CodeWriter::WriteDest::~WriteDest()
 {
-    m_os.flush();
     m_outFile.close();
 }
 
 
+void CodeWriter::WriteDest::write(const CodeBuffer &code)
+{
+    if (code.isEmpty()) {
+        m_outFile.write("\n");
+    }
+    else {
+        code.writeTo(m_outFile);
+    }
+}
+
+
 CodeWriter::CodeWriter()
 {
 }
 
 
-bool CodeWriter::writeCode(const Module *module, const QStringList &lines)
+bool CodeWriter::writeCode(const Module *module, const CodeBuffer &code)
 {
     WriteDestMap::iterator it = m_dests.find(module);
 
@@ -58,6 +70,12 @@ bool CodeWriter::writeCode(const Module *module, const QStringList &lines)
     }
 
     assert(it != m_dests.end());
-    it->second << lines.join('\n') << '\n';
+    it->second.write(code);
     return true;
 }
+
+
+void CodeWriter::closeAll()
+{
+    m_dests.clear();
+}
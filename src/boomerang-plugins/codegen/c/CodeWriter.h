@@ -10,14 +10,12 @@
 #pragma once
 
 
-#include "boomerang/util/OStream.h"
-
 #include <QFile>
-#include <QStringList>
 
 #include <map>
 
 
+class CodeBuffer;
 class Module;
 
 
@@ -37,17 +35,11 @@ class CodeWriter
         WriteDest &operator=(WriteDest &&) = delete;
 
     public:
-        template<typename T>
-        OStream &operator<<(T val)
-        {
-            m_os << val;
-            m_os.flush();
-            return m_os;
-        }
+        /// Append \p code to the output file.
+        void write(const CodeBuffer &code);
 
     private:
         QFile m_outFile;
-        OStream m_os;
     };
 
     typedef std::map<const Module *, WriteDest> WriteDestMap;
@@ -63,7 +55,11 @@ public:
     CodeWriter &operator=(CodeWriter &&) = default;
 
 public:
-    bool writeCode(const Module *module, const QStringList &lines);
+    /// Append \p code to the output file of \p module.
+    bool writeCode(const Module *module, const CodeBuffer &code);
+
+    /// Close all output files. Writing to a module afterwards truncates its output file.
+    void closeAll();
 
 private:
     WriteDestMap m_dests;
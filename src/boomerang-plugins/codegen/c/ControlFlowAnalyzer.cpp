@@ -13,6 +13,8 @@
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+
 
 // index of the "then" branch of conditional jumps
 #define BTHEN 0
@@ -181,7 +183,7 @@ void ControlFlowAnalyzer::structConds()
 }
 
 
-void ControlFlowAnalyzer::determineLoopType(const IRFragment *header, bool *&loopNodes)
+void ControlFlowAnalyzer::determineLoopType(const IRFragment *header, int loopID)
 {
     assert(getLatchNode(header));
 
@@ -200,7 +202,7 @@ void ControlFlowAnalyzer::determineLoopType(const IRFragment *header, bool *&loo
         // if the header is a two way node then it must have a conditional follow (since it can't
         // have any backedges leading from it). If this follow is within the loop then this must be
         // an endless loop
-        if (getCondFollow(header) && loopNodes[getPostOrdering(getCondFollow(header))]) {
+        if (getCondFollow(header) && isInLoop(getCondFollow(header), loopID)) {
             setLoopType(header, LoopType::Endless);
 
             // retain the fact that this is also a conditional header
@@ -217,7 +219,8 @@ void ControlFlowAnalyzer::determineLoopType(const IRFragment *header, bool *&loo
 }
 
 
-void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNodes)
+void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, int loopID,
+                                         const std::vector<const IRFragment *> &members)
 {
     assert(getStructType(header) == StructType::Loop ||
            getStructType(header) == StructType::LoopCond);
@@ -227,7 +230,7 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
     if (loopType == LoopType::PreTested) {
         // if the 'while' loop's true child is within the loop, then its false child is the loop
         // follow
-        if (loopNodes[getPostOrdering(header->getSuccessor(BTHEN))]) {
+        if (isInLoop(header->getSuccessor(BTHEN), loopID)) {
             setLoopFollow(header, header->getSuccessor(BELSE));
         }
         else {
@@ -248,10 +251,18 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
         // endless loop
         const IRFragment *follow = nullptr;
 
-        // traverse the ordering array between the header and latch nodes.
-        // IRFragment * latch = header->getLatchNode(); initialized at function start
-        for (int i = getPostOrdering(header) - 1; i > getPostOrdering(latch); i--) {
-            const IRFragment *&desc = m_postOrdering[i];
+        // Traverse the loop members between the header and latch nodes in the same order
+        // as the ordering array. Nodes that are not members of the loop are not considered anyway.
+        int nextOrdering = getPostOrdering(header);
+
+        for (const IRFragment *desc : members) {
+            if (getPostOrdering(desc) >= nextOrdering) {
+                continue; // skipped by jumping to a conditional follow
+            }
+            else if (getPostOrdering(desc) <= getPostOrdering(latch)) {
+                break;
+            }
+
             // the follow for an endless loop will have the following
             // properties:
             //   i) it will have a parent that is a conditional header inside the loop whose follow
@@ -261,11 +272,11 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
 
             if ((getStructType(desc) == StructType::Cond) && getCondFollow(desc) &&
                 (getLoopHead(desc) == header)) {
-                if (loopNodes[getPostOrdering(getCondFollow(desc))]) {
+                if (isInLoop(getCondFollow(desc), loopID)) {
                     // if the conditional's follow is in the same loop AND is lower in the loop,
                     // jump to this follow
                     if (getPostOrdering(desc) > getPostOrdering(getCondFollow(desc))) {
-                        i = getPostOrdering(getCondFollow(desc));
+                        nextOrdering = getPostOrdering(getCondFollow(desc));
                     }
                     else {
                         // otherwise there is a backward jump somewhere to a node earlier in this
@@ -279,8 +290,8 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
                     // the same loop
                     const IRFragment *succ = desc->getSuccessor(BTHEN);
 
-                    if (loopNodes[getPostOrdering(succ)]) {
-                        if (!loopNodes[getPostOrdering(desc->getSuccessor(BELSE))]) {
+                    if (isInLoop(succ, loopID)) {
+                        if (!isInLoop(desc->getSuccessor(BELSE), loopID)) {
                             succ = desc->getSuccessor(BELSE);
                         }
                         else {
@@ -306,10 +317,11 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
 }
 
 
-void ControlFlowAnalyzer::tagNodesInLoop(const IRFragment *header, bool *&loopNodes)
+void ControlFlowAnalyzer::tagNodesInLoop(const IRFragment *header, int loopID,
+                                         std::vector<const IRFragment *> &members)
 {
-    // Traverse the ordering structure from the header to the latch node tagging the nodes
-    // determined to be within the loop. These are nodes that satisfy the following:
+    // Tag the nodes between the header and the latch node in the ordering structure
+    // that are determined to be within the loop. These are nodes that satisfy the following:
     //    i)   header.loopStamps encloses curNode.loopStamps and curNode.loopStamps encloses
     //         latch.loopStamps
     //    OR
@@ -317,23 +329,62 @@ void ControlFlowAnalyzer::tagNodesInLoop(const IRFragment *header, bool *&loopNo
     //         header.revLoopStamps
     //    OR
     //  iii) curNode is the latch node
+    //
+    // The nodes satisfying i) or ii) are exactly the nodes on the path from the latch node
+    // to the header in the respective DFS tree, so we do not need to visit any other nodes.
 
     const IRFragment *latch = getLatchNode(header);
     assert(latch);
 
-    for (int i = getPostOrdering(header) - 1; i >= getPostOrdering(latch); i--) {
-        if (isFragInLoop(m_postOrdering[i], header, latch)) {
-            // update the membership map to reflect that this node is within the loop
-            loopNodes[i] = true;
+    const int lowOrdering  = getPostOrdering(latch);
+    const int highOrdering = getPostOrdering(header) - 1;
+
+    auto tagNode = [&](const IRFragment *frag) {
+        const int ordering = getPostOrdering(frag);
 
-            setLoopHead(m_postOrdering[i], header);
+        if (ordering >= lowOrdering && ordering <= highOrdering && !isInLoop(frag, loopID)) {
+            assert(isFragInLoop(frag, header, latch));
+            m_info[frag].m_loopID = loopID;
+            setLoopHead(frag, header);
+            members.push_back(frag);
+        }
+    };
+
+    tagNode(latch);
+
+    if (m_info[header].m_preOrderID < m_info[latch].m_preOrderID &&
+        m_info[latch].m_postOrderID < m_info[header].m_postOrderID) {
+        for (const IRFragment *frag = m_info[latch].m_dfsParent; frag != header;) {
+            tagNode(frag);
+            frag = m_info[frag].m_dfsParent;
         }
     }
+
+    if (m_info[header].m_revPreOrderID < m_info[latch].m_revPreOrderID &&
+        m_info[latch].m_revPostOrderID < m_info[header].m_revPostOrderID) {
+        for (const IRFragment *frag = m_info[latch].m_revDfsParent; frag != header;) {
+            tagNode(frag);
+            frag = m_info[frag].m_revDfsParent;
+        }
+    }
+
+    std::sort(members.begin(), members.end(), [this](const IRFragment *a, const IRFragment *b) {
+        return getPostOrdering(a) > getPostOrdering(b);
+    });
 }
 
 
 void ControlFlowAnalyzer::structLoops()
 {
+    // Loops are discovered from the outermost to the innermost loop,
+    // so inner loops override the loop IDs and heads of their members.
+    int numLoops = 0;
+    std::vector<const IRFragment *> loopMembers;
+
+    for (const IRFragment *frag : m_postOrdering) {
+        m_info[frag].m_loopID = -1;
+    }
+
     for (int i = m_postOrdering.size() - 1; i >= 0; i--) {
         const IRFragment *currFrag = m_postOrdering[i]; // the current node under investigation
         const IRFragment *latch    = nullptr;           // the latching node of the loop
@@ -364,13 +415,7 @@ void ControlFlowAnalyzer::structLoops()
             continue;
         }
 
-        // define the map that maps each node to whether or not it is within the current loop
-        bool *loopNodes = new bool[m_postOrdering.size()];
-
-        for (unsigned int j = 0; j < m_postOrdering.size(); j++) {
-            loopNodes[j] = false;
-        }
-
+        const int loopID = numLoops++;
         setLatchNode(currFrag, latch);
 
         // the latching node may already have been structured as a conditional header. If it is
@@ -384,15 +429,14 @@ void ControlFlowAnalyzer::structLoops()
         setStructType(currFrag, StructType::Loop);
 
         // tag the members of this loop
-        tagNodesInLoop(currFrag, loopNodes);
+        loopMembers.clear();
+        tagNodesInLoop(currFrag, loopID, loopMembers);
 
         // calculate the type of this loop
-        determineLoopType(currFrag, loopNodes);
+        determineLoopType(currFrag, loopID);
 
         // calculate the follow node of this loop
-        findLoopFollow(currFrag, loopNodes);
-
-        delete[] loopNodes;
+        findLoopFollow(currFrag, loopID, loopMembers);
     }
 }
 
@@ -537,6 +581,7 @@ void ControlFlowAnalyzer::updateLoopStamps(const IRFragment *frag, int &time)
 
         // recurse on this child if it hasn't already been visited
         if (getTravType(succ) != TravType::DFS_LNum) {
+            m_info[succ].m_dfsParent = frag;
             updateLoopStamps(succ, ++time);
         }
     }
@@ -560,6 +605,7 @@ void ControlFlowAnalyzer::updateRevLoopStamps(const IRFragment *frag, int &time)
     for (int i = frag->getNumSuccessors() - 1; i >= 0; i--) {
         // recurse on this child if it hasn't already been visited
         if (getTravType(frag->getSuccessor(i)) != TravType::DFS_RNum) {
+            m_info[frag->getSuccessor(i)].m_revDfsParent = frag;
             updateRevLoopStamps(frag->getSuccessor(i), ++time);
         }
     }
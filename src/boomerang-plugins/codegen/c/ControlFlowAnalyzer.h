@@ -101,6 +101,14 @@ struct FragStructInfo
     /* for traversal */
     TravType m_travType = TravType::Untraversed; ///< traversal flag for the numerous DFS's
 
+    const IRFragment *m_dfsParent    = nullptr; ///< parent in the DFS tree of the graph
+    const IRFragment *m_revDfsParent = nullptr; ///< parent in the reverse DFS tree of the graph
+
+    /// ID of the most nested loop this node is a member of, or -1 if none.
+    /// For loop headers, this is the ID of the enclosing loop, so the loop IDs of all headers
+    /// form the loop nesting forest.
+    int m_loopID = -1;
+
     /* high level structuring */
     StructFragType
         m_loopCondType = StructFragType::None; ///< type of conditional to treat this loop header as
@@ -274,16 +282,25 @@ private:
 
     /// \pre  The loop induced by (head,latch) has already had all its member nodes tagged
     /// \post The type of loop has been deduced
-    void determineLoopType(const IRFragment *header, bool *&loopNodes);
+    void determineLoopType(const IRFragment *header, int loopID);
 
     /// \pre  The loop headed by header has been induced and all it's member nodes have been tagged
     /// \post The follow of the loop has been determined.
-    void findLoopFollow(const IRFragment *header, bool *&loopNodes);
+    void findLoopFollow(const IRFragment *header, int loopID,
+                        const std::vector<const IRFragment *> &members);
 
     /// \pre header has been detected as a loop header and has the details of the
     ///        latching node
-    /// \post the nodes within the loop have been tagged
-    void tagNodesInLoop(const IRFragment *header, bool *&loopNodes);
+    /// \post the nodes within the loop have been tagged with \p loopID and are stored in
+    ///        \p members, ordered by descending post ordering
+    void tagNodesInLoop(const IRFragment *header, int loopID,
+                        std::vector<const IRFragment *> &members);
+
+    /// \returns true if \p frag has been tagged as a member of the loop \p loopID
+    bool isInLoop(const IRFragment *frag, int loopID) const
+    {
+        return m_info[frag].m_loopID == loopID;
+    }
 
     IRFragment *findEntryFragment() const;
     IRFragment *findExitFragment() const;
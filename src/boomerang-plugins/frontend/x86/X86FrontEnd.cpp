@@ -59,7 +59,7 @@ bool X86FrontEnd::liftProcImpl(UserProc *proc)
     processStringInst(proc);
 
     IRFragment::RTLIterator rit;
-    StatementList::iterator sit;
+    RTL::iterator sit;
     ProcCFG *procCFG = proc->getCFG();
 
     for (IRFragment *frag : *procCFG) {
@@ -169,6 +169,9 @@ bool X86FrontEnd::initialize(Project *project)
     }
 
     m_decoder = plugin->getIfc<IDecoder>();
+    m_overlappedRegsProcessed.clear();
+    m_floatProcessed.clear();
+
     return DefaultFrontEnd::initialize(project);
 }
 
@@ -322,10 +325,9 @@ void X86FrontEnd::processOverlapped(UserProc *proc)
 {
     // first, lets look for any uses of the registers
     std::set<RegNum> usedRegs;
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         LocationSet locs;
         s->addUsedLocs(locs);
 
@@ -338,7 +340,7 @@ void X86FrontEnd::processOverlapped(UserProc *proc)
 
     std::set<IRFragment *> frags;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (isOverlappedRegsProcessed(s->getFragment())) { // never redo processing
             continue;
         }
@@ -79,15 +79,30 @@ bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePa
 bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, const Prog *prog,
                                             CallConv cc)
 {
-    AnsiCParserDriver driver;
-    if (driver.parse(signatureFile, prog->getMachine(), cc) != 0) {
-        LOG_ERROR("Cannot read library signature file '%1'", signatureFile);
-        return false;
+    const QString cacheKey = QString("%1|%2|%3")
+                                 .arg(signatureFile)
+                                 .arg(static_cast<int>(prog->getMachine()))
+                                 .arg(static_cast<int>(cc));
+
+    auto it = m_signatureFileCache.find(cacheKey);
+    if (it == m_signatureFileCache.end()) {
+        AnsiCParserDriver driver;
+        if (driver.parse(signatureFile, prog->getMachine(), cc) != 0) {
+            LOG_ERROR("Cannot read library signature file '%1'", signatureFile);
+            return false;
+        }
+
+        std::vector<std::shared_ptr<Signature>> signatures;
+        for (std::shared_ptr<Signature> &signature : driver.signatures) {
+            signature->setSigFilePath(signatureFile);
+            signatures.push_back(signature);
+        }
+
+        it = m_signatureFileCache.insert(cacheKey, signatures);
     }
 
-    for (std::shared_ptr<Signature> &signature : driver.signatures) {
+    for (const std::shared_ptr<Signature> &signature : it.value()) {
         m_librarySignatures[signature->getName()] = signature;
-        signature->setSigFilePath(signatureFile);
     }
 
     return true;
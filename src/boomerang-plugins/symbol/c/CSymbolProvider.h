@@ -16,6 +16,8 @@
 
 #include <QMap>
 
+#include <vector>
+
 
 class Prog;
 
@@ -43,4 +45,9 @@ private:
 
 private:
     QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+
+    /// Signatures read from each signature file, keyed by file, machine and calling convention.
+    /// Keeps the signatures warm when more than one binary is loaded during the lifetime
+    /// of the plugin.
+    QMap<QString, std::vector<std::shared_ptr<Signature>>> m_signatureFileCache;
 };
@@ -41,15 +41,20 @@
 #include "boomerang/ssl/type/SizeType.h"
 #include "boomerang/ssl/type/UnionType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/LocationSet.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expvisitor/ConstFinder.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
 #include "boomerang/visitor/stmtexpvisitor/StmtConstFinder.h"
 
+#include <algorithm>
 #include <cstring>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 #define DFA_ITER_LIMIT (100)
@@ -64,9 +69,9 @@ DFATypeRecovery::DFATypeRecovery(Project *project)
 }
 
 
-void DFATypeRecovery::printResults(StatementList &stmts, int iter)
+void DFATypeRecovery::printResults(const std::vector<SharedStmt> &stmts, std::size_t numVisits)
 {
-    LOG_VERBOSE("%1 iterations", iter);
+    LOG_VERBOSE("%1 statement visits", numVisits);
 
     for (SharedStmt s : stmts) {
         LOG_VERBOSE("%1", s); // Print the statement; has dest type
@@ -247,52 +252,106 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
 
     // First use the type information from the signature.
     // Sometimes needed to split variables
-    bool ch = dfaTypeAnalysis(proc->getSignature().get(), cfg);
-    StatementList stmts;
-    proc->getStatements(stmts);
+    dfaTypeAnalysis(proc->getSignature().get(), cfg);
 
-    int iter = 0;
+    // Statements may be added or removed below, so keep a snapshot of them
+    const auto stmts                        = proc->getStatementIndex();
+    const UserProc::StatementIndex &stmtVec = *stmts;
 
-    for (iter = 1; iter <= DFA_ITER_LIMIT; ++iter) {
-        ch = false;
+    // Sparse def-use information: When the type of a statement changes, only the statements
+    // it uses and the statements using them need to be analyzed again.
+    std::unordered_map<const Statement *, std::size_t> stmtIndex;
 
-        for (SharedStmt stmt : stmts) {
-            SharedStmt before = nullptr;
+    for (std::size_t i = 0; i < stmtVec.size(); ++i) {
+        stmtIndex[stmtVec[i].get()] = i;
+    }
 
-            if (proc->getProg()->getProject()->getSettings()->debugTA) {
-                before = stmt->clone();
-            }
+    std::vector<std::vector<std::size_t>> defsOf(stmtVec.size());
+    std::vector<std::vector<std::size_t>> usersOf(stmtVec.size());
 
-            DFATypeAnalyzer ana;
-            stmt->accept(&ana);
-            const bool thisCh = ana.hasChanged();
+    for (std::size_t i = 0; i < stmtVec.size(); ++i) {
+        LocationSet refs;
+        stmtVec[i]->addUsedLocs(refs);
 
-            if (thisCh) {
-                ch = true;
+        for (const SharedExp &ref : refs) {
+            if (!ref->isSubscript() || !ref->access<RefExp>()->getDef()) {
+                continue;
+            }
 
-                if (proc->getProg()->getProject()->getSettings()->debugTA) {
-                    LOG_VERBOSE("  Caused change:\n"
-                                "    FROM: %1\n"
-                                "    TO:   %2",
-                                before, stmt);
-                }
+            auto it = stmtIndex.find(ref->access<RefExp>()->getDef().get());
+            if (it == stmtIndex.end() || it->second == i) {
+                continue;
             }
+
+            defsOf[i].push_back(it->second);
+            usersOf[it->second].push_back(i);
         }
+    }
+
+    // Sparse worklist: Every statement is analyzed once (ordered by statement position,
+    // like the round robin algorithm). After that, only the neighbours in the def-use graph
+    // of statements whose type changed are analyzed again.
+    const std::size_t maxVisits = DFA_ITER_LIMIT * stmtVec.size();
+    std::size_t numVisits       = 0;
+    std::set<std::size_t> workSet;
+
+    for (std::size_t i = 0; i < stmtVec.size(); ++i) {
+        workSet.insert(workSet.end(), i);
+    }
+
+    while (!workSet.empty() && numVisits < maxVisits) {
+        const std::size_t idx = *workSet.begin();
+        workSet.erase(workSet.begin());
+        numVisits++;
 
-        if (!ch) {
-            // No more changes: round robin algorithm terminates
-            break;
+        const SharedStmt &stmt = stmtVec[idx];
+        SharedStmt before      = nullptr;
+
+        if (proc->getProg()->getProject()->getSettings()->debugTA) {
+            before = stmt->clone();
+        }
+
+        DFATypeAnalyzer ana;
+        stmt->accept(&ana);
+
+        if (!ana.hasChanged()) {
+            continue;
+        }
+
+        if (proc->getProg()->getProject()->getSettings()->debugTA) {
+            LOG_VERBOSE("  Caused change:\n"
+                        "    FROM: %1\n"
+                        "    TO:   %2",
+                        before, stmt);
+        }
+
+        for (std::size_t user : usersOf[idx]) {
+            workSet.insert(user);
+        }
+
+        // The types of the definitions may have changed as well
+        for (std::size_t def : defsOf[idx]) {
+            workSet.insert(def);
+
+            for (std::size_t user : usersOf[def]) {
+                if (user != idx) {
+                    workSet.insert(user);
+                }
+            }
         }
     }
 
-    if (ch) {
+    if (!workSet.empty()) {
         LOG_VERBOSE("Iteration limit exceeded for dfaTypeAnalysis of procedure '%1'",
                     proc->getName());
     }
 
+    LOG_VERBOSE("Data-flow based type analysis for '%1': %2 statements, %3 visits",
+                proc->getName(), stmtVec.size(), numVisits);
+
     if (proc->getProg()->getProject()->getSettings()->debugTA) {
         LOG_MSG("### Results for data-flow based type analysis for %1 ###", proc->getName());
-        printResults(stmts, iter);
+        printResults(stmtVec, numVisits);
         LOG_MSG("### End results for data-flow based type analysis for %1 ###", proc->getName());
     }
 
@@ -300,7 +359,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
     Prog *_prog = proc->getProg();
     DataIntervalMap localsMap(proc); // map of all local variables of proc
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmtVec) {
         // 1) constants
         std::list<std::shared_ptr<Const>> constList;
         findConstantsInStmt(s, constList);
@@ -530,7 +589,7 @@ bool DFATypeRecovery::doEllipsisProcessing(UserProc *proc)
 
     for (IRFragment *frag : *proc->getCFG()) {
         IRFragment::RTLRIterator rrit;
-        StatementList::reverse_iterator srit;
+        RTL::reverse_iterator srit;
         std::shared_ptr<CallStatement> c = std::dynamic_pointer_cast<CallStatement>(
             frag->getLastStmt(rrit, srit));
 
@@ -16,11 +16,11 @@
 #include "boomerang/ssl/statements/Statement.h"
 
 #include <list>
+#include <vector>
 
 
 class ProcCFG;
 class Signature;
-class StatementList;
 class UserProc;
 class Const;
 
@@ -51,11 +51,16 @@ public:
     void recoverFunctionTypes(Function *function) override;
 
 private:
+    /**
+     * Propagate types between all statements of \p proc until no change.
+     * Statements are re-analyzed only when the type of a statement connected to them
+     * in the def-use graph changed.
+     */
     void dfaTypeAnalysis(UserProc *proc);
     bool dfaTypeAnalysis(Signature *signature, ProcCFG *cfg);
     //     bool dfaTypeAnalysis(const SharedStmt &stmt);
 
-    void printResults(StatementList &stmts, int iter);
+    void printResults(const std::vector<SharedStmt> &stmts, std::size_t numVisits);
 
     /// Replace array references of the form m[idx*K1 + K2]
     /// in \p s. Create global array variables as needed.
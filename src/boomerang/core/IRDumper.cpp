@@ -0,0 +1,245 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IRDumper.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/statements/Statement.h"
+
+#include <QDir>
+#include <QFile>
+
+#include <algorithm>
+
+
+/// Diffs with more edits than this replace all changed lines instead
+/// (the memory needed for the diff grows quadratically with the number of edits).
+static constexpr const int MAX_DIFF_EDITS = 1000;
+
+
+/// \returns a regular expression matching whole names only. Empty patterns match everything.
+static QRegularExpression makeFilter(const QString &pattern)
+{
+    if (pattern.isEmpty()) {
+        return QRegularExpression();
+    }
+
+    return QRegularExpression("^(?:" + pattern + ")$");
+}
+
+
+bool IRDumper::setProcFilter(const QString &pattern)
+{
+    const QRegularExpression filter = makeFilter(pattern);
+    if (!filter.isValid()) {
+        return false;
+    }
+
+    m_procFilter = filter;
+    m_enabled    = true;
+    return true;
+}
+
+
+bool IRDumper::setPassFilter(const QString &pattern)
+{
+    const QRegularExpression filter = makeFilter(pattern);
+    if (!filter.isValid()) {
+        return false;
+    }
+
+    m_passFilter = filter;
+    return true;
+}
+
+
+void IRDumper::disable()
+{
+    m_enabled = false;
+    m_dumps.clear();
+}
+
+
+void IRDumper::dumpAfterPass(UserProc *proc, const QString &passName)
+{
+    if (!m_enabled || !m_procFilter.match(proc->getName()).hasMatch()) {
+        return;
+    }
+
+    auto it              = m_dumps.find(proc);
+    const bool firstDump = (it == m_dumps.end());
+
+    if (firstDump) {
+        it = m_dumps.insert({ proc, ProcDump() }).first;
+    }
+
+    ProcDump &dump = it->second;
+    dump.numPasses++;
+
+    if (!m_passFilter.match(passName).hasMatch()) {
+        return;
+    }
+
+    std::vector<QString> lines    = takeSnapshot(proc);
+    const std::vector<Edit> edits = diff(dump.lines, lines);
+
+    if (!firstDump && edits.empty()) {
+        return;
+    }
+
+    QFile file(getDumpFilePath(proc));
+    if (!file.open(firstDump ? (QFile::WriteOnly | QFile::Truncate) : QFile::Append)) {
+        return;
+    }
+
+    const std::size_t numInserted = std::count_if(edits.begin(), edits.end(),
+                                                  [](const Edit &edit) { return edit.isInsert; });
+
+    QString hunk;
+    if (firstDump) {
+        hunk += QString("# IR dump of '%1'\n").arg(proc->getName());
+    }
+
+    hunk += QString("@@ %1 '%2' -%3 +%4\n")
+                .arg(dump.numPasses)
+                .arg(passName)
+                .arg(edits.size() - numInserted)
+                .arg(numInserted);
+
+    for (const Edit &edit : edits) {
+        const QString &line = edit.isInsert ? lines[edit.index] : dump.lines[edit.index];
+        hunk += QString("%1%2 %3\n").arg(edit.isInsert ? '+' : '-').arg(edit.index).arg(line);
+    }
+
+    file.write(hunk.toUtf8());
+    dump.lines = std::move(lines);
+}
+
+
+QString IRDumper::getDumpFilePath(const UserProc *proc)
+{
+    const QDir outputDir = proc->getProg()->getProject()->getSettings()->getOutputDirectory();
+    return outputDir.absoluteFilePath(proc->getName() + ".irdump");
+}
+
+
+std::vector<IRDumper::Edit> IRDumper::diff(const std::vector<QString> &from,
+                                           const std::vector<QString> &to)
+{
+    // Lines in the common prefix and suffix are unchanged; only diff the lines in between.
+    std::size_t prefix = 0;
+    while (prefix < from.size() && prefix < to.size() && from[prefix] == to[prefix]) {
+        prefix++;
+    }
+
+    std::size_t suffix = 0;
+    while (suffix < from.size() - prefix && suffix < to.size() - prefix &&
+           from[from.size() - 1 - suffix] == to[to.size() - 1 - suffix]) {
+        suffix++;
+    }
+
+    const int n = static_cast<int>(from.size() - prefix - suffix);
+    const int m = static_cast<int>(to.size() - prefix - suffix);
+
+    // Myers' algorithm: v[offset + k] is the furthest x reached on diagonal k = x - y.
+    // trace[d] is the part of v used in step d (diagonals -d-1 to d+1).
+    const int maxEdits = std::min(n + m, MAX_DIFF_EDITS);
+    const int offset   = maxEdits + 1;
+
+    std::vector<int> v(2 * offset + 1, 0);
+    std::vector<std::vector<int>> trace;
+    bool found = false;
+
+    for (int d = 0; d <= maxEdits && !found; ++d) {
+        trace.emplace_back(v.begin() + offset - d - 1, v.begin() + offset + d + 2);
+
+        for (int k = -d; k <= d; k += 2) {
+            int x = (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1]))
+                        ? v[offset + k + 1]      // insertion
+                        : v[offset + k - 1] + 1; // deletion
+            int y = x - k;
+
+            while (x < n && y < m && from[prefix + x] == to[prefix + y]) {
+                x++;
+                y++;
+            }
+
+            v[offset + k] = x;
+
+            if (x >= n && y >= m) {
+                found = true;
+                break;
+            }
+        }
+    }
+
+    std::vector<Edit> result;
+
+    if (!found) {
+        // Too many changes; replace all lines between the common prefix and suffix.
+        for (int i = 0; i < n; ++i) {
+            result.push_back({ false, prefix + i });
+        }
+
+        for (int i = 0; i < m; ++i) {
+            result.push_back({ true, prefix + i });
+        }
+
+        return result;
+    }
+
+    // Walk back from the end to the start, collecting the edits in reverse order.
+    int x = n;
+    int y = m;
+
+    for (int d = static_cast<int>(trace.size()) - 1; d > 0; --d) {
+        const std::vector<int> &prevV = trace[d];
+        const int k                   = x - y;
+
+        const bool isInsert = (k == -d || (k != d && prevV[d + k] < prevV[d + k + 2]));
+        const int prevK     = isInsert ? k + 1 : k - 1;
+        const int prevX     = prevV[d + prevK + 1];
+        const int prevY     = prevX - prevK;
+
+        if (isInsert) {
+            result.push_back({ true, prefix + prevY });
+        }
+        else {
+            result.push_back({ false, prefix + prevX });
+        }
+
+        x = prevX;
+        y = prevY;
+    }
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+
+std::vector<QString> IRDumper::takeSnapshot(UserProc *proc) const
+{
+    std::vector<QString> lines;
+
+    for (IRFragment *frag : *proc->getCFG()) {
+        const QString fragAddr = frag->getLowAddr().toString();
+
+        IRFragment::RTLIterator rit;
+        RTL::iterator sit;
+        for (SharedStmt s = frag->getFirstStmt(rit, sit); s; s = frag->getNextStmt(rit, sit)) {
+            lines.push_back(fragAddr + " " + s->toString().simplified());
+        }
+    }
+
+    return lines;
+}
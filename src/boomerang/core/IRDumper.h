@@ -0,0 +1,108 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QRegularExpression>
+#include <QString>
+
+#include <map>
+#include <vector>
+
+
+class UserProc;
+
+
+/**
+ * Dumps the IR of selected procedures after selected passes.
+ * Only the statements that changed since the previous dump of a procedure are written,
+ * as a line based diff. The dumps of each procedure are written to
+ * <output directory>/<procedure name>.irdump:
+ *
+ * \code
+ * # IR dump of 'main'
+ * @@ 7 'StatementPropagation' -1 +1
+ * -12 0x08048410 5 *32* r24 := m[r28 + 4]
+ * +12 0x08048410 5 *32* r24 := 5
+ * \endcode
+ *
+ * Each hunk starts with the number of passes executed for the procedure so far,
+ * the name of the pass and the number of deleted and inserted statements.
+ * Deleted statements are prefixed by their index in the previous dump,
+ * inserted statements by their index in the current dump. The first hunk of a procedure
+ * inserts all statements. scripts/print-ir-dump.py reconstructs the full IR after any hunk.
+ *
+ * The dumper is disabled by default; while disabled, dumping does not cost more than a branch.
+ */
+class BOOMERANG_API IRDumper
+{
+public:
+    /// A deleted or inserted statement in a diff between two dumps.
+    struct Edit
+    {
+        bool isInsert;     ///< true for inserted statements, false for deleted statements
+        std::size_t index; ///< Index in the new dump for insertions, in the old dump otherwise
+    };
+
+public:
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * Enable dumping of all procedures whose name matches the regular expression \p pattern.
+     * \returns false if \p pattern is not a valid regular expression.
+     */
+    bool setProcFilter(const QString &pattern);
+
+    /**
+     * Only dump after passes whose name matches the regular expression \p pattern.
+     * By default, procedures are dumped after every pass.
+     * \returns false if \p pattern is not a valid regular expression.
+     */
+    bool setPassFilter(const QString &pattern);
+
+    /// Disable dumping and discard all previous dumps.
+    void disable();
+
+    /**
+     * Write the statements of \p proc that changed since the last dump of \p proc,
+     * if \p proc and the pass \p passName are selected.
+     */
+    void dumpAfterPass(UserProc *proc, const QString &passName);
+
+    /// \returns the path of the file the dumps of \p proc are written to.
+    static QString getDumpFilePath(const UserProc *proc);
+
+    /**
+     * \returns a shortest edit script transforming \p from into \p to,
+     * ordered by position. If the difference is very large, all lines between the common
+     * prefix and suffix are replaced instead.
+     */
+    static std::vector<Edit> diff(const std::vector<QString> &from,
+                                  const std::vector<QString> &to);
+
+private:
+    /// \returns one line per statement of \p proc
+    std::vector<QString> takeSnapshot(UserProc *proc) const;
+
+private:
+    struct ProcDump
+    {
+        std::vector<QString> lines; ///< Statements as of the last dump
+        int numPasses = 0;          ///< Number of passes executed since dumping started
+    };
+
+    bool m_enabled = false;
+    QRegularExpression m_procFilter;
+    QRegularExpression m_passFilter;
+
+    std::map<const UserProc *, ProcDump> m_dumps;
+};
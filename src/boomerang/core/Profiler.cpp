@@ -0,0 +1,241 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "Profiler.h"
+
+#include "boomerang/db/proc/Proc.h"
+#include "boomerang/util/Util.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cassert>
+
+
+static const char *getCategoryName(ProfileCategory category)
+{
+    switch (category) {
+    case ProfileCategory::Phase: return "phase";
+    case ProfileCategory::Proc: return "proc";
+    case ProfileCategory::Pass: return "pass";
+    }
+
+    return "";
+}
+
+
+/// \returns \p duration in (fractional) microseconds, the time unit of trace events
+static double toMicroseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+
+/// \returns \p duration in (fractional) seconds
+static double toSeconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+
+static bool writeJSONFile(const QString &filePath, const QJsonObject &root)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
+
+    return file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) != -1;
+}
+
+
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !m_enabled) {
+        clear();
+    }
+
+    m_enabled = enabled;
+}
+
+
+void Profiler::clear()
+{
+    assert(m_depth == 0);
+
+    m_startTime = std::chrono::steady_clock::now();
+    m_scopes.clear();
+    m_counters.clear();
+}
+
+
+std::size_t Profiler::beginScope(ProfileCategory category, const QString &name,
+                                 const Function *proc)
+{
+    Scope scope;
+    scope.name        = name;
+    scope.procName    = proc ? proc->getName() : QString();
+    scope.category    = category;
+    scope.depth       = m_depth++;
+    scope.start       = std::chrono::steady_clock::now() - m_startTime;
+    scope.duration    = std::chrono::nanoseconds::zero();
+    scope.memoryUsage = 0;
+
+    m_scopes.push_back(scope);
+    return m_scopes.size() - 1;
+}
+
+
+void Profiler::endScope(std::size_t scopeIdx)
+{
+    assert(scopeIdx < m_scopes.size());
+    Scope &scope = m_scopes[scopeIdx];
+
+    scope.duration = std::chrono::steady_clock::now() - m_startTime - scope.start;
+    m_depth--;
+
+    // Sampling memory usage is a system call, so do it only for the coarse scopes.
+    if (scope.category != ProfileCategory::Pass) {
+        scope.memoryUsage = Util::getCurrentMemoryUsage();
+    }
+}
+
+
+void Profiler::addScope(ProfileCategory category, const QString &name, const Function *proc,
+                        std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end)
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    Scope scope;
+    scope.name        = name;
+    scope.procName    = proc ? proc->getName() : QString();
+    scope.category    = category;
+    scope.depth       = m_depth;
+    scope.start       = start - m_startTime;
+    scope.duration    = end - start;
+    scope.memoryUsage = 0;
+
+    m_scopes.push_back(scope);
+}
+
+
+bool Profiler::writeJSON(const QString &filePath) const
+{
+    QJsonArray scopes;
+
+    // total time and number of invocations per category and name
+    std::map<QString, std::map<QString, std::pair<std::chrono::nanoseconds, int>>> summary;
+
+    for (const Scope &scope : m_scopes) {
+        QJsonObject jsonScope;
+        jsonScope["name"]     = scope.name;
+        jsonScope["category"] = getCategoryName(scope.category);
+        jsonScope["depth"]    = scope.depth;
+        jsonScope["start"]    = toSeconds(scope.start);
+        jsonScope["time"]     = toSeconds(scope.duration);
+
+        if (!scope.procName.isEmpty()) {
+            jsonScope["proc"] = scope.procName;
+        }
+
+        if (scope.memoryUsage != 0) {
+            jsonScope["rss"] = static_cast<qint64>(scope.memoryUsage);
+        }
+
+        scopes.append(jsonScope);
+
+        auto &entry = summary[getCategoryName(scope.category)][scope.name];
+        entry.first += scope.duration;
+        entry.second++;
+    }
+
+    QJsonObject jsonSummary;
+    for (const auto &[category, names] : summary) {
+        QJsonObject jsonCategory;
+
+        for (const auto &[name, entry] : names) {
+            QJsonObject jsonEntry;
+            jsonEntry["time"]  = toSeconds(entry.first);
+            jsonEntry["count"] = entry.second;
+            jsonCategory[name] = jsonEntry;
+        }
+
+        jsonSummary[category] = jsonCategory;
+    }
+
+    QJsonObject counters;
+    for (const auto &[name, value] : m_counters) {
+        counters[name] = static_cast<qint64>(value);
+    }
+
+    QJsonObject root;
+    root["scopes"]   = scopes;
+    root["summary"]  = jsonSummary;
+    root["counters"] = counters;
+    root["peakRSS"]  = static_cast<qint64>(Util::getPeakMemoryUsage());
+
+    return writeJSONFile(filePath, root);
+}
+
+
+bool Profiler::writeChromeTrace(const QString &filePath) const
+{
+    QJsonArray events;
+
+    for (const Scope &scope : m_scopes) {
+        QJsonObject event;
+        event["name"] = scope.procName.isEmpty() || scope.category == ProfileCategory::Pass
+                            ? scope.name
+                            : QString("%1 %2").arg(scope.name, scope.procName);
+        event["cat"]  = getCategoryName(scope.category);
+        event["ph"]   = "X";
+        event["ts"]   = toMicroseconds(scope.start);
+        event["dur"]  = toMicroseconds(scope.duration);
+        event["pid"]  = 1;
+        event["tid"]  = 1;
+
+        if (!scope.procName.isEmpty()) {
+            QJsonObject args;
+            args["proc"]  = scope.procName;
+            event["args"] = args;
+        }
+
+        events.append(event);
+
+        if (scope.memoryUsage != 0) {
+            QJsonObject args;
+            args["RSS (MiB)"] = static_cast<double>(scope.memoryUsage) / (1024 * 1024);
+
+            QJsonObject sample;
+            sample["name"] = "memory";
+            sample["ph"]   = "C";
+            sample["ts"]   = toMicroseconds(scope.start + scope.duration);
+            sample["pid"]  = 1;
+            sample["args"] = args;
+            events.append(sample);
+        }
+    }
+
+    QJsonObject counters;
+    for (const auto &[name, value] : m_counters) {
+        counters[name] = static_cast<qint64>(value);
+    }
+
+    QJsonObject root;
+    root["traceEvents"]     = events;
+    root["displayTimeUnit"] = "ms";
+    root["otherData"]       = counters;
+
+    return writeJSONFile(filePath, root);
+}
@@ -0,0 +1,171 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+
+class Function;
+
+
+enum class ProfileCategory : uint8
+{
+    Phase, ///< A phase of the pipeline (e.g. decoding) or of the whole-program analysis
+    Proc,  ///< A stage of the decompilation of a single procedure
+    Pass   ///< A single pass executed for a procedure
+};
+
+
+/**
+ * Records where time and memory go during decompilation.
+ * Time is measured by hierarchical scopes (see \ref ProfileScope), memory usage is sampled
+ * at the end of each phase and procedure scope, and events can be counted by name.
+ * The results can be written as JSON or in Chrome trace event format, which can be viewed
+ * in chrome://tracing or in Perfetto.
+ *
+ * The profiler is disabled by default; while disabled, scopes and counters do not cost
+ * more than a branch.
+ * \note Not thread safe. All scopes must be opened and closed on the same thread.
+ */
+class BOOMERANG_API Profiler
+{
+public:
+    struct Scope
+    {
+        QString name;
+        QString procName; ///< Name of the procedure the scope belongs to, if any
+        ProfileCategory category;
+        int depth;                         ///< Nesting depth; top level scopes have depth 0
+        std::chrono::nanoseconds start;    ///< Relative to the time profiling was enabled
+        std::chrono::nanoseconds duration; ///< Zero while the scope is open
+        std::size_t memoryUsage;           ///< RSS at the end of the scope in bytes, or 0
+    };
+
+public:
+    Profiler() = default;
+    Profiler(const Profiler &other) = delete;
+    Profiler(Profiler &&other)      = default;
+
+    ~Profiler() = default;
+
+    Profiler &operator=(const Profiler &other) = delete;
+    Profiler &operator=(Profiler &&other) = default;
+
+public:
+    bool isEnabled() const { return m_enabled; }
+
+    /// Enabling the profiler discards all data recorded so far.
+    void setEnabled(bool enabled);
+
+    /// Discard all recorded scopes and counters.
+    void clear();
+
+    /// Add \p delta to the counter named \p name.
+    void addToCounter(const char *name, sint64 delta = 1)
+    {
+        if (m_enabled) {
+            m_counters[name] += delta;
+        }
+    }
+
+    /**
+     * Record a scope that was measured elsewhere, e.g. on a worker thread.
+     * The scope is nested in the innermost open scope. Its memory usage is not sampled,
+     * since other scopes may have run at the same time.
+     */
+    void addScope(ProfileCategory category, const QString &name, const Function *proc,
+                  std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point end);
+
+    /// \returns all scopes in the order they were opened
+    const std::vector<Scope> &getScopes() const { return m_scopes; }
+
+    const std::map<QString, sint64> &getCounters() const { return m_counters; }
+
+    /**
+     * Write all scopes and counters to \p filePath as JSON,
+     * together with the total time and number of invocations per scope name and category.
+     * \returns true on success.
+     */
+    bool writeJSON(const QString &filePath) const;
+
+    /**
+     * Write all scopes and memory samples to \p filePath in Chrome trace event format.
+     * \returns true on success.
+     */
+    bool writeChromeTrace(const QString &filePath) const;
+
+private:
+    friend class ProfileScope;
+
+    /// \returns the index of the new scope
+    std::size_t beginScope(ProfileCategory category, const QString &name, const Function *proc);
+    void endScope(std::size_t scopeIdx);
+
+private:
+    bool m_enabled = false;
+    int m_depth    = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    std::vector<Scope> m_scopes;
+    std::map<QString, sint64> m_counters;
+};
+
+
+/**
+ * Measures the time from its construction to its destruction
+ * if \p profiler is enabled, and does nothing otherwise.
+ */
+class BOOMERANG_API ProfileScope
+{
+public:
+    ProfileScope(Profiler *profiler, ProfileCategory category, const char *name,
+                 const Function *proc = nullptr)
+        : m_profiler(profiler && profiler->isEnabled() ? profiler : nullptr)
+    {
+        if (m_profiler) {
+            m_scopeIdx = m_profiler->beginScope(category, name, proc);
+        }
+    }
+
+    ProfileScope(Profiler *profiler, ProfileCategory category, const QString &name,
+                 const Function *proc = nullptr)
+        : m_profiler(profiler && profiler->isEnabled() ? profiler : nullptr)
+    {
+        if (m_profiler) {
+            m_scopeIdx = m_profiler->beginScope(category, name, proc);
+        }
+    }
+
+    ProfileScope(const ProfileScope &other) = delete;
+    ProfileScope(ProfileScope &&other)      = delete;
+
+    ~ProfileScope()
+    {
+        if (m_profiler) {
+            m_profiler->endScope(m_scopeIdx);
+        }
+    }
+
+    ProfileScope &operator=(const ProfileScope &other) = delete;
+    ProfileScope &operator=(ProfileScope &&other) = delete;
+
+private:
+    Profiler *m_profiler;
+    std::size_t m_scopeIdx = 0;
+};
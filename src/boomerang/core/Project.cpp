@@ -11,20 +11,56 @@
 
 #include "boomerang/core/Settings.h"
 #include "boomerang/core/Watcher.h"
+#include "boomerang/db/LowLevelCFG.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/decomp/ProgDecompiler.h"
 #include "boomerang/util/CallGraphDotWriter.h"
 #include "boomerang/util/ProgSymbolWriter.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
 #include <stdexcept>
 
 
+/// Appends the wall time and peak memory usage of the enclosing scope to a list of phase stats,
+/// and records the scope with the profiler if it is enabled.
+class ScopedPhaseStats
+{
+public:
+    ScopedPhaseStats(std::vector<PhaseStats> &stats, Profiler *profiler, const char *name)
+        : m_stats(stats)
+        , m_name(name)
+        , m_startTime(std::chrono::steady_clock::now())
+        , m_startPeakMemoryUsage(Util::getPeakMemoryUsage())
+        , m_profileScope(profiler, ProfileCategory::Phase, name)
+    {
+    }
+
+    ~ScopedPhaseStats()
+    {
+        const std::size_t peakMemoryUsage = Util::getPeakMemoryUsage();
+
+        m_stats.push_back({ m_name, std::chrono::steady_clock::now() - m_startTime,
+                            peakMemoryUsage, peakMemoryUsage - m_startPeakMemoryUsage });
+    }
+
+private:
+    std::vector<PhaseStats> &m_stats;
+    const char *m_name;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::size_t m_startPeakMemoryUsage;
+    ProfileScope m_profileScope;
+};
+
+
 Project::Project()
     : m_settings(new Settings())
     , m_pluginManager(new PluginManager(this))
+    , m_profiler(new Profiler())
+    , m_irDumper(new IRDumper())
 {
 }
 
@@ -110,6 +146,9 @@ bool Project::loadBinaryFile(const QString &filePath)
 {
     LOG_MSG("Loading binary file '%1'", filePath);
 
+    m_phaseStats.clear();
+    ScopedPhaseStats phase(m_phaseStats, m_profiler.get(), "load");
+
     // Find loader plugin to load file
     IFileLoader *loader = getBestLoader(filePath);
 
@@ -163,6 +202,7 @@ bool Project::isBinaryLoaded() const
 
 void Project::unloadBinaryFile()
 {
+    m_decompiler.reset();
     m_prog.reset();
     m_loadedBinary.reset();
 }
@@ -179,6 +219,7 @@ bool Project::decodeBinaryFile()
         return false;
     }
 
+    ScopedPhaseStats phase(m_phaseStats, m_profiler.get(), "decode");
     loadSymbols();
 
     if (!getSettings()->m_entryPoints.empty()) { // decode only specified procs
@@ -192,6 +233,10 @@ bool Project::decodeBinaryFile()
         return false;
     }
 
+    if (!getSettings()->m_rootProcs.empty() && !pruneUnreachableProcs()) {
+        return false;
+    }
+
     this->alertEndDecode();
 
     LOG_MSG("Found %1 procs", m_prog->getNumFunctions());
@@ -219,14 +264,31 @@ bool Project::decompileBinaryFile()
         return false;
     }
 
+    ScopedPhaseStats phase(m_phaseStats, m_profiler.get(), "decompile");
+
     LOG_MSG("Decompiling...");
-    ProgDecompiler dcomp(m_prog.get());
-    dcomp.decompile();
+    getOrCreateDecompiler()->decompile();
 
     return true;
 }
 
 
+bool Project::decompileProc(UserProc *proc)
+{
+    if (!m_prog) {
+        LOG_ERROR("Cannot decompile procedure: No binary file is loaded.");
+        return false;
+    }
+    else if (!m_fe) {
+        LOG_ERROR("Cannot decompile procedure: No suitable frontend found.");
+        return false;
+    }
+
+    ScopedPhaseStats phase(m_phaseStats, m_profiler.get(), "decompileProc");
+    return getOrCreateDecompiler()->decompileOnDemand(proc);
+}
+
+
 bool Project::generateCode(Module *module)
 {
     if (!m_prog) {
@@ -238,6 +300,8 @@ bool Project::generateCode(Module *module)
         return false;
     }
 
+    ScopedPhaseStats phase(m_phaseStats, m_profiler.get(), "codegen");
+
     LOG_MSG("Generating code...");
     for (auto &plugin : m_pluginManager->getPluginsByType(PluginType::CodeGenerator)) {
         ICodeGenerator *gen = plugin->getIfc<ICodeGenerator>();
@@ -248,6 +312,33 @@ bool Project::generateCode(Module *module)
 }
 
 
+void Project::setDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    m_deadline = deadline;
+}
+
+
+void Project::clearDeadline()
+{
+    m_deadline = std::chrono::steady_clock::time_point::max();
+}
+
+
+bool Project::isDeadlineExpired() const
+{
+    return m_deadline != std::chrono::steady_clock::time_point::max() &&
+           std::chrono::steady_clock::now() >= m_deadline;
+}
+
+
+void Project::checkDeadline() const
+{
+    if (isDeadlineExpired()) {
+        throw DeadlineExpiredError("Decompilation deadline expired");
+    }
+}
+
+
 Prog *Project::createProg(BinaryFile *file, const QString &name)
 {
     if (!file) {
@@ -257,6 +348,7 @@ Prog *Project::createProg(BinaryFile *file, const QString &name)
 
     // unload old Prog before creating a new one
     m_fe = nullptr;
+    m_decompiler.reset();
     m_prog.reset();
 
     m_prog.reset(new Prog(name, this));
@@ -332,7 +424,11 @@ bool Project::decodeAll()
         m_prog->addEntryPoint(mainAddr);
     }
 
-    if (getSettings()->decodeChildren) {
+    if (getSettings()->decodeOnDemand) {
+        // All other procs are decoded when they are decompiled
+        LOG_MSG("Decoding other procedures on demand");
+    }
+    else if (getSettings()->decodeChildren) {
         // this causes any undecoded userprocs to be decoded
         LOG_MSG("Decoding anything undecoded...");
         if (!m_fe->disassembleAll()) {
@@ -345,6 +441,96 @@ bool Project::decodeAll()
 }
 
 
+bool Project::pruneUnreachableProcs()
+{
+    std::vector<Address> roots = getSettings()->m_entryPoints;
+
+    for (const QString &rootName : getSettings()->m_rootProcs) {
+        const Address rootAddr = findRootProc(rootName);
+
+        if (rootAddr == Address::INVALID) {
+            LOG_ERROR("Cannot find root procedure '%1'", rootName);
+            return false;
+        }
+        else if (!m_prog->decodeEntryPoint(rootAddr)) {
+            LOG_ERROR("Cannot decode root procedure '%1'", rootName);
+            return false;
+        }
+
+        roots.push_back(rootAddr);
+    }
+
+    // Decode the callees of roots that were not decoded before
+    if (getSettings()->decodeChildren && !getSettings()->decodeOnDemand &&
+        !m_fe->disassembleAll()) {
+        LOG_ERROR("Aborting load due to decode failure");
+        return false;
+    }
+
+    std::set<Address> reachable;
+    std::vector<Address> toVisit = roots;
+
+    while (!toVisit.empty()) {
+        const Address addr = toVisit.back();
+        toVisit.pop_back();
+
+        if (!reachable.insert(addr).second) {
+            continue;
+        }
+
+        for (Address callee : m_prog->getCFG()->getCallees(addr)) {
+            toVisit.push_back(callee);
+        }
+    }
+
+    std::vector<QString> unreachable;
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *function : *module) {
+            if (!function->isLib() && reachable.count(function->getEntryAddress()) == 0) {
+                unreachable.push_back(function->getName());
+            }
+        }
+    }
+
+    for (const QString &name : unreachable) {
+        m_prog->removeFunction(name);
+    }
+
+    LOG_MSG("Removed %1 procedures not reachable from the root procedures", unreachable.size());
+    m_profiler->addToCounter("prunedProcs", unreachable.size());
+    return true;
+}
+
+
+Address Project::findRootProc(const QString &rootName) const
+{
+    const Function *proc = m_prog->getFunctionByName(rootName);
+    if (proc) {
+        return proc->getEntryAddress();
+    }
+
+    const BinarySymbol *sym = m_loadedBinary->getSymbols()->findSymbolByName(rootName);
+    if (sym && !sym->isImportedFunction()) {
+        return sym->getLocation();
+    }
+
+    bool converted       = false;
+    const Address result = Address(rootName.toLongLong(&converted, 0));
+
+    return converted ? result : Address::INVALID;
+}
+
+
+ProgDecompiler *Project::getOrCreateDecompiler()
+{
+    if (!m_decompiler) {
+        m_decompiler.reset(new ProgDecompiler(m_prog.get()));
+    }
+
+    return m_decompiler.get();
+}
+
+
 void Project::loadPlugins()
 {
     LOG_MSG("Loading plugins...");
@@ -432,6 +618,8 @@ void Project::alertSignatureUpdated(Function *function)
 
 void Project::alertInstructionDecoded(Address pc, int numBytes)
 {
+    m_profiler->addToCounter("decodedInstructions");
+
     for (IWatcher *it : m_watchers) {
         it->onInstructionDecoded(pc, numBytes);
     }
@@ -440,6 +628,8 @@ void Project::alertInstructionDecoded(Address pc, int numBytes)
 
 void Project::alertBadDecode(Address pc)
 {
+    m_profiler->addToCounter("badDecodes");
+
     for (IWatcher *it : m_watchers) {
         it->onBadDecode(pc);
     }
@@ -488,6 +678,8 @@ void Project::alertProcStatusChanged(UserProc *proc)
 
 void Project::alertEndDecompile(UserProc *proc)
 {
+    m_profiler->addToCounter("decompiledProcs");
+
     for (IWatcher *it : m_watchers) {
         it->onEndDecompile(proc);
     }
@@ -11,12 +11,18 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/core/IRDumper.h"
+#include "boomerang/core/Profiler.h"
 #include "boomerang/core/plugin/PluginManager.h"
 #include "boomerang/ifc/IFileLoader.h"
 #include "boomerang/util/Address.h"
 
+#include <QString>
+
+#include <chrono>
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <vector>
 
 
@@ -28,10 +34,35 @@ class ITypeRecovery;
 class IWatcher;
 class Module;
 class Prog;
+class ProgDecompiler;
 class Settings;
 class UserProc;
 
-class QString;
+
+/// Thrown out of the decompiler when the deadline of the project has passed.
+/// \sa Project::setDeadline
+class BOOMERANG_API DeadlineExpiredError : public std::runtime_error
+{
+public:
+    explicit DeadlineExpiredError(const char *what)
+        : std::runtime_error(what)
+    {
+    }
+};
+
+
+/// Wall time and memory usage of one phase (load, decode, decompile, codegen) of the pipeline.
+struct BOOMERANG_API PhaseStats
+{
+    QString name;
+    std::chrono::steady_clock::duration time;
+    /// Peak RSS of the process at the end of the phase, in bytes. This includes all previous
+    /// phases, so it is the cumulative peak, not the peak of this phase alone.
+    std::size_t peakMemoryUsage;
+
+    /// How much this phase raised the peak RSS of the process, in bytes.
+    std::size_t peakMemoryGrowth;
+};
 
 
 class BOOMERANG_API Project
@@ -63,6 +94,15 @@ public:
     PluginManager *getPluginManager();
     const PluginManager *getPluginManager() const;
 
+    /// \returns the profiler recording phase, procedure and pass timings (disabled by default)
+    Profiler *getProfiler() { return m_profiler.get(); }
+    const Profiler *getProfiler() const { return m_profiler.get(); }
+
+    /// \returns the dumper writing the IR of selected procedures after each pass
+    /// (disabled by default)
+    IRDumper *getIRDumper() { return m_irDumper.get(); }
+    const IRDumper *getIRDumper() const { return m_irDumper.get(); }
+
 public:
     /// \returns the library version string
     const char *getVersionStr() const;
@@ -117,12 +157,42 @@ public:
      */
     bool decompileBinaryFile();
 
+    /**
+     * Decompile \p proc on demand, together with all procedures it calls,
+     * without decompiling the rest of the program. Results are kept, so decompiling
+     * the same procedure or one of its callees again is cheap.
+     * \returns true on success, false if no binary is decoded or \p proc cannot be decompiled.
+     */
+    bool decompileProc(UserProc *proc);
+
     /**
      * Generate code for \p module, or all modules if \p module is nullptr.
      * \returns true on success, false if no binary is decompiled or an error occurred.
      */
     bool generateCode(Module *module = nullptr);
 
+    /**
+     * Abort decompilation as soon as \p deadline has passed.
+     * The deadline is checked before each pass is executed, before each procedure is decoded
+     * and before code is generated for each procedure; if it has expired,
+     * a \ref DeadlineExpiredError is thrown. The Prog is left in an undefined state
+     * and must be unloaded afterwards.
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+    /// Remove the deadline set by \ref setDeadline.
+    void clearDeadline();
+
+    /// \returns true iff a deadline was set and has already passed.
+    bool isDeadlineExpired() const;
+
+    /// Throw a \ref DeadlineExpiredError if the deadline has already passed.
+    void checkDeadline() const;
+
+    /// \returns the wall time and peak memory usage of all phases run
+    /// since the binary file was loaded, in order of execution.
+    const std::vector<PhaseStats> &getPhaseStats() const { return m_phaseStats; }
+
 public:
     /// Register a watcher to receive events about the decompilation.
     /// Does NOT take ownership of the pointer.
@@ -204,6 +274,22 @@ private:
      */
     bool decodeAll();
 
+    /**
+     * Remove all procedures that are not reachable from the procedures in
+     * \ref Settings::m_rootProcs and \ref Settings::m_entryPoints in the call graph found
+     * during decoding, so they are never lifted or decompiled.
+     * Root procedures which are not decoded yet are decoded first.
+     * \returns false iff a root procedure could not be found or decoded.
+     */
+    bool pruneUnreachableProcs();
+
+    /// \returns the entry address of the procedure with the name or address \p rootName,
+    /// or Address::INVALID if there is no such procedure.
+    Address findRootProc(const QString &rootName) const;
+
+    /// \returns the decompiler of the current Prog, creating it if necessary.
+    ProgDecompiler *getOrCreateDecompiler();
+
 private:
     std::unique_ptr<Settings> m_settings;
 
@@ -214,6 +300,13 @@ private:
 
     std::unique_ptr<BinaryFile> m_loadedBinary;
     std::unique_ptr<Prog> m_prog;
+    std::unique_ptr<ProgDecompiler> m_decompiler; ///< Keeps results of on-demand decompilation
 
     IFrontEnd *m_fe = nullptr;
+
+    std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
+
+    std::vector<PhaseStats> m_phaseStats;
+    std::unique_ptr<Profiler> m_profiler;
+    std::unique_ptr<IRDumper> m_irDumper;
 };
@@ -59,6 +59,7 @@ public:
     bool useLocals           = true;
     bool removeLabels        = true;
     bool useDataflow         = true;
+    bool usePrunedSSA        = false; ///< Only place phi functions for live locations
     bool stopBeforeDecompile = false;
     bool traceDecoder        = false;
 
@@ -74,6 +75,7 @@ public:
     bool removeReturns     = true;
     bool decodeThruIndCall = false;
     bool decodeChildren    = true;
+    bool decodeOnDemand    = false; ///< Only decode procedures when they are decompiled
     bool useProof          = true;
     bool changeSignatures  = true;
     bool useTypeAnalysis   = true;
@@ -83,12 +85,23 @@ public:
     bool useGlobals        = true;
     bool assumeABI         = false; ///< Assume ABI compliance
 
+    /// When the passes executed for a single procedure take longer than this many seconds
+    /// or exceed this number of passes, the rest of the procedure is decompiled
+    /// with a reduced pipeline. 0 means no limit.
+    int procTimeBudget = 0;
+    int procPassBudget = 0;
+
     QString replayFile;  ///< file with commands to execute in interactive mode
     QString sslFileName; ///< Use this SSL file instead of one of the hard-coded ones.
 
     /// Contains all known entrypoints for the Prog.
     std::vector<Address> m_entryPoints;
 
+    /// Names or addresses of the procedures to restrict decompilation to. If not empty,
+    /// only these procedures, the procedures at \ref m_entryPoints and their callees
+    /// are decompiled.
+    std::vector<QString> m_rootProcs;
+
     /// A vector containing the names of all symbol files to load.
     std::vector<QString> m_symbolFiles;
 
@@ -314,16 +314,43 @@ bool DataFlow::placePhiFunctions()
     m_definedAt.resize(numFrags);
 
     const bool assumeABICompliance = m_proc->getProg()->getProject()->getSettings()->assumeABI;
+    const bool prune               = m_proc->getProg()->getProject()->getSettings()->usePrunedSSA;
+
+    // For pruning: Locations used in fragment n before being defined in n
+    std::vector<ExSet> usedBeforeDef(prune ? numFrags : 0);
+
+    // For pruning: The collectors of calls and returns use all locations. These are the
+    // locations defined in fragment n before the first call or return of n.
+    std::vector<ExSet> definedBeforeCollector(prune ? numFrags : 0);
+    std::vector<bool> hasCollector(prune ? numFrags : 0, false);
 
     // We need to create m_definedAt[n] for all n
     // Recreate each call because propagation and other changes make old data invalid
     for (FragIndex n{ 0 }; n < numFrags; ++n) {
         IRFragment::RTLIterator rit;
-        StatementList::iterator sit;
+        RTL::iterator sit;
         IRFragment *frag = m_frags[n];
 
         for (SharedStmt stmt = frag->getFirstStmt(rit, sit); stmt;
              stmt            = frag->getNextStmt(rit, sit)) {
+            if (prune) {
+                if ((stmt->isCall() || stmt->isReturn()) && !hasCollector[n]) {
+                    hasCollector[n]           = true;
+                    definedBeforeCollector[n] = m_definedAt[n];
+                }
+
+                LocationSet usedLocs;
+                stmt->addUsedLocs(usedLocs);
+
+                for (const SharedExp &used : usedLocs) {
+                    const SharedExp base = used->isSubscript() ? used->getSubExp1() : used;
+
+                    if (canPrune(base) && !m_definedAt[n].contains(base)) {
+                        usedBeforeDef[n].insert(base->clone());
+                    }
+                }
+            }
+
             LocationSet locationSet;
             stmt->getDefinitions(locationSet, assumeABICompliance);
 
@@ -358,9 +385,59 @@ bool DataFlow::placePhiFunctions()
         }
     }
 
+    int numPhis       = 0; // number of new phi functions placed
+    int numPrunedPhis = 0; // number of phi functions not placed because of pruning
+
     // For each variable a defined anywhere
     for (auto &[a, defsites] : m_defsites) {
         std::set<FragIndex> W = defsites;
+        std::set<FragIndex> prunedAt; // fragments where the phi for a was pruned
+        std::set<FragIndex> liveIn;
+
+        const bool pruneA = prune && canPrune(a);
+
+        if (pruneA) {
+            // Find all fragments where a is live on entry by propagating
+            // upwards exposed uses backwards until a definition of a.
+            std::set<FragIndex> liveWork;
+
+            for (FragIndex n{ 0 }; n < numFrags; ++n) {
+                if (usedBeforeDef[n].contains(a) ||
+                    (hasCollector[n] && !definedBeforeCollector[n].contains(a))) {
+                    liveWork.insert(n);
+                }
+            }
+
+            // Phi functions placed previously use a at the end of each predecessor
+            for (FragIndex y : m_A_phi[a]) {
+                for (IRFragment *pred : m_frags[y]->getPredecessors()) {
+                    const FragIndex p = fragToIdx(pred);
+
+                    if (!m_definedAt[p].contains(a) &&
+                        m_defallsites.find(p) == m_defallsites.end()) {
+                        liveWork.insert(p);
+                    }
+                }
+            }
+
+            while (!liveWork.empty()) {
+                const FragIndex n = *liveWork.begin();
+                liveWork.erase(liveWork.begin());
+
+                if (!liveIn.insert(n).second) {
+                    continue;
+                }
+
+                for (IRFragment *pred : m_frags[n]->getPredecessors()) {
+                    const FragIndex p = fragToIdx(pred);
+
+                    if (liveIn.find(p) == liveIn.end() && !m_definedAt[p].contains(a) &&
+                        m_defallsites.find(p) == m_defallsites.end()) {
+                        liveWork.insert(p);
+                    }
+                }
+            }
+        }
 
         while (!W.empty()) {
             // Pop first node from W
@@ -372,10 +449,24 @@ bool DataFlow::placePhiFunctions()
                 if (m_A_phi[a].find(y) != m_A_phi[a].end()) {
                     continue;
                 }
+                else if (pruneA && liveIn.find(y) == liveIn.end()) {
+                    // a is dead at the beginning of y, so the phi would be unused.
+                    // Continue with the iterated dominance frontier nevertheless.
+                    if (prunedAt.insert(y).second) {
+                        numPrunedPhis++;
+
+                        if (!m_definedAt[y].contains(a)) {
+                            W.insert(y);
+                        }
+                    }
+
+                    continue;
+                }
 
                 // Insert trivial phi function for a at top of block y: a := phi()
                 change = true;
                 m_frags[y]->addPhi(a->clone());
+                numPhis++;
 
                 // A_phi[a] <- A_phi[a] U {y}
                 m_A_phi[a].insert(y);
@@ -389,10 +480,23 @@ bool DataFlow::placePhiFunctions()
         }
     }
 
+    if (prune) {
+        LOG_VERBOSE("Placed %1 phi functions in '%2' (%3 without pruning)", numPhis,
+                    m_proc->getName(), numPhis + numPrunedPhis);
+    }
+
     return change;
 }
 
 
+bool DataFlow::canPrune(const SharedConstExp &exp) const
+{
+    // Restricted to locations where a use always matches a definition exactly.
+    // Memory locations might alias each other.
+    return exp->isRegOfConst() || exp->isTemp() || exp->isFlags() || exp->isMainFlag();
+}
+
+
 void DataFlow::convertImplicits()
 {
     ProcCFG *cfg = m_proc->getCFG();
@@ -51,6 +51,8 @@ public:
     bool calculateDominators();
 
     /// Place phi functions.
+    /// If enabled by \ref Settings::usePrunedSSA, phi functions for registers and flags
+    /// are only placed where the location is live on entry (pruned SSA form).
     /// \returns true if any change
     bool placePhiFunctions();
 
@@ -121,6 +123,9 @@ private:
 
     bool canRenameLocalsParams() const { return renameLocalsAndParams; }
 
+    /// \returns true if phi functions for \p exp may be omitted if \p exp is not live.
+    bool canPrune(const SharedConstExp &exp) const;
+
     void clearA_phi() { m_A_phi.clear(); }
 
 private:
@@ -10,6 +10,8 @@
 #include "DefCollector.h"
 
 #include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/Util.h"
 
 #include <QtAlgorithms>
@@ -18,24 +20,111 @@
 #define DEFCOL_COLS 120
 
 
+/// The definitions of empty collectors. Must stay empty.
+static AssignSet &noDefs()
+{
+    static AssignSet defs;
+    return defs;
+}
+
+
+bool DefCollectorPool::LessDefs::operator()(const AssignSet *left, const AssignSet *right) const
+{
+    if (left->size() != right->size()) {
+        return left->size() < right->size();
+    }
+
+    // Both sets are sorted by LHS
+    for (auto l = left->begin(), r = right->begin(); l != left->end(); ++l, ++r) {
+        const Assign &la = **l;
+        const Assign &ra = **r;
+
+        if (*la.getLeft() < *ra.getLeft()) {
+            return true;
+        }
+        else if (*ra.getLeft() < *la.getLeft()) {
+            return false;
+        }
+        else if (*la.getRight() < *ra.getRight()) {
+            return true;
+        }
+        else if (*ra.getRight() < *la.getRight()) {
+            return false;
+        }
+        else if (la.getType() != ra.getType()) {
+            if (!la.getType() || !ra.getType()) {
+                return la.getType() == nullptr;
+            }
+            else if (*la.getType() < *ra.getType()) {
+                return true;
+            }
+            else if (*ra.getType() < *la.getType()) {
+                return false;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+std::shared_ptr<AssignSet> DefCollectorPool::intern(const std::shared_ptr<AssignSet> &defs)
+{
+    auto it = m_defs.find(defs.get());
+    if (it != m_defs.end()) {
+        return it->second;
+    }
+
+    m_defs.insert({ defs.get(), defs });
+    return defs;
+}
+
+
 DefCollector::~DefCollector()
 {
 }
 
 
-void DefCollector::makeCloneOf(const DefCollector &other)
+DefCollector::iterator DefCollector::begin()
+{
+    if (!m_defs) {
+        return noDefs().begin();
+    }
+
+    return getWritableDefs().begin();
+}
+
+
+DefCollector::iterator DefCollector::end()
 {
-    m_defs.clear();
+    if (!m_defs) {
+        return noDefs().end();
+    }
+
+    return getWritableDefs().end();
+}
+
 
-    for (const auto &elem : other) {
-        m_defs.insert(elem->clone()->as<Assign>());
+void DefCollector::makeCloneOf(const DefCollector &other)
+{
+    if (other.m_defs && !other.m_defs->empty()) {
+        m_defs = other.m_defs;
+    }
+    else {
+        m_defs = nullptr;
     }
 }
 
 
+bool DefCollector::isSharedWith(const DefCollector &other) const
+{
+    return m_defs != nullptr && m_defs == other.m_defs;
+}
+
+
 void DefCollector::clear()
 {
-    m_defs.clear();
+    m_defs = nullptr;
 }
 
 
@@ -45,13 +134,13 @@ void DefCollector::collectDef(const std::shared_ptr<Assign> &a)
         return;
     }
 
-    m_defs.insert(a);
+    getWritableDefs().insert(a);
 }
 
 
 bool DefCollector::hasDefOf(const SharedExp &e) const
 {
-    return m_defs.definesLoc(e);
+    return m_defs && m_defs->definesLoc(e);
 }
 
 
@@ -59,7 +148,7 @@ SharedExp DefCollector::findDefFor(const SharedExp &e) const
 {
     assert(e != nullptr);
 
-    for (std::shared_ptr<Assign> def : m_defs) {
+    for (const std::shared_ptr<Assign> &def : getDefs()) {
         if (*def->getLeft() == *e) {
             return def->getRight();
         }
@@ -70,25 +159,41 @@ SharedExp DefCollector::findDefFor(const SharedExp &e) const
 
 
 void DefCollector::updateDefs(std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> &Stacks,
-                              UserProc *proc)
+                              UserProc *proc, DefCollectorPool *pool)
 {
+    bool changed = false;
+
     for (auto &Stack : Stacks) {
         if (Stack.second.empty()) {
             continue; // This variable's definition doesn't reach here
         }
+        else if (hasDefOf(Stack.first)) {
+            // Already collected; checking first avoids creating the assignment
+            // and un-sharing the definitions when nothing changes.
+            continue;
+        }
 
         // Create an assignment of the form loc := loc{def}
         auto re = RefExp::get(Stack.first->clone(), Stack.second.top());
         std::shared_ptr<Assign> as(new Assign(Stack.first->clone(), re));
         as->setProc(proc); // Simplify sometimes needs this
-        collectDef(as);
+        getWritableDefs().insert(as);
+        changed = true;
+    }
+
+    if (changed && pool) {
+        m_defs = pool->intern(m_defs);
     }
 }
 
 
 void DefCollector::searchReplaceAll(const Exp &from, SharedExp to, bool &changed)
 {
-    for (auto def : m_defs) {
+    if (!m_defs) {
+        return;
+    }
+
+    for (const std::shared_ptr<Assign> &def : getWritableDefs()) {
         changed |= def->searchAndReplace(from, to);
     }
 }
@@ -96,7 +201,7 @@ void DefCollector::searchReplaceAll(const Exp &from, SharedExp to, bool &changed
 
 void DefCollector::print(OStream &os) const
 {
-    if (m_defs.empty()) {
+    if (getDefs().empty()) {
         os << "<None>";
         return;
     }
@@ -104,7 +209,7 @@ void DefCollector::print(OStream &os) const
     size_t col = 36;
     bool first = true;
 
-    for (auto def : m_defs) {
+    for (const std::shared_ptr<Assign> &def : getDefs()) {
         QString tgt;
         OStream ost(&tgt);
         def->getLeft()->print(ost);
@@ -132,3 +237,29 @@ void DefCollector::print(OStream &os) const
         col += len;
     }
 }
+
+
+const AssignSet &DefCollector::getDefs() const
+{
+    return m_defs ? *m_defs : noDefs();
+}
+
+
+AssignSet &DefCollector::getWritableDefs()
+{
+    if (!m_defs) {
+        m_defs = std::make_shared<AssignSet>();
+    }
+    else if (m_defs.use_count() > 1) {
+        // Shared with another collector; clone the definitions before they are modified
+        std::shared_ptr<AssignSet> defs = std::make_shared<AssignSet>();
+
+        for (const std::shared_ptr<Assign> &def : *m_defs) {
+            defs->insert(def->clone()->as<Assign>());
+        }
+
+        m_defs = defs;
+    }
+
+    return *m_defs;
+}
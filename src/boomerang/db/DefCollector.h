@@ -14,6 +14,7 @@
 #include "boomerang/util/StatementSet.h"
 
 #include <map>
+#include <memory>
 #include <stack>
 
 
@@ -21,9 +22,40 @@ class Statement;
 class UserProc;
 
 
+/**
+ * Shares the definitions collected by \ref DefCollector::updateDefs between all collectors
+ * that are reached by the same definitions. While the pool holds the definitions,
+ * a collector modifying them clones them first.
+ */
+class BOOMERANG_API DefCollectorPool
+{
+public:
+    /// \returns a set with the same definitions as \p defs. If the pool already contains
+    /// such a set, it is returned instead of \p defs; otherwise \p defs is added to the pool.
+    std::shared_ptr<AssignSet> intern(const std::shared_ptr<AssignSet> &defs);
+
+    /// Remove all definitions from the pool
+    void clear() { m_defs.clear(); }
+
+private:
+    /// Compares the definitions of two sets (LHS, RHS and type of each assignment)
+    struct LessDefs
+    {
+        bool operator()(const AssignSet *left, const AssignSet *right) const;
+    };
+
+    std::map<const AssignSet *, std::shared_ptr<AssignSet>, LessDefs> m_defs;
+};
+
+
 /**
  * This class collects all definitions that reach the statement
  * that contains this collector.
+ *
+ * Collectors that were cloned from each other or whose definitions were interned by the same
+ * \ref DefCollectorPool share their definitions until one of them is modified (copy-on-write).
+ * Since the definitions themselves can be modified via non-const iterators, non-const access
+ * to a shared collector clones the definitions first, like for implicitly shared Qt containers.
  */
 class BOOMERANG_API DefCollector
 {
@@ -42,15 +74,21 @@ public:
     DefCollector &operator=(DefCollector &&other) = default;
 
 public:
-    iterator begin() { return m_defs.begin(); }
-    iterator end() { return m_defs.end(); }
-    const_iterator begin() const { return m_defs.begin(); }
-    const_iterator end() const { return m_defs.end(); }
+    /// Non-const iteration clones shared definitions first,
+    /// but does not allocate definitions for an empty collector.
+    iterator begin();
+    iterator end();
+    const_iterator begin() const { return getDefs().begin(); }
+    const_iterator end() const { return getDefs().end(); }
 
 public:
-    /// Clone the given Collector into this one (discard existing data)
+    /// Clone the given Collector into this one (discard existing data).
+    /// The definitions are shared with \p other until either collector is modified.
     void makeCloneOf(const DefCollector &other);
 
+    /// \returns true if this collector shares its definitions with \p other
+    bool isSharedWith(const DefCollector &other) const;
+
     /// Remove all collected definitions
     void clear();
 
@@ -65,17 +103,28 @@ public:
     SharedExp findDefFor(const SharedExp &e) const;
 
     /// Update the definitions with the current set of reaching definitions
-    /// \p proc is the enclosing procedure
+    /// \p proc is the enclosing procedure. If \p pool is not null, the updated definitions
+    /// are shared with other collectors of the pool that have the same definitions.
     void updateDefs(std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> &Stacks,
-                    UserProc *proc);
+                    UserProc *proc, DefCollectorPool *pool = nullptr);
 
     /// Search and replace all occurrences
     void searchReplaceAll(const Exp &pattern, SharedExp replacement, bool &change);
 
+    /// \returns all collected definitions
+    const AssignSet &getDefs() const;
+
 public:
     /// Print the collected locations to stream \p os
     void print(OStream &os) const;
 
 private:
-    AssignSet m_defs; ///< The set of definitions.
+    /// \returns the definitions for modification. Clones the definitions first
+    /// if they are shared with another collector.
+    AssignSet &getWritableDefs();
+
+private:
+    /// The set of definitions, or nullptr if there are none.
+    /// Shared between collectors cloned from each other until one of them is modified.
+    std::shared_ptr<AssignSet> m_defs;
 };
@@ -245,7 +245,7 @@ std::shared_ptr<ImplicitAssign> IRFragment::addImplicitAssign(const SharedExp &l
     assert(m_listOfRTLs);
 
     if (m_listOfRTLs->empty() || m_listOfRTLs->front()->getAddress() != Address::ZERO) {
-        m_listOfRTLs->push_front(std::unique_ptr<RTL>(new RTL(Address::ZERO)));
+        m_listOfRTLs->insert(m_listOfRTLs->begin(), std::make_unique<RTL>(Address::ZERO));
     }
 
     // do not allow BB with 2 zero address RTLs
@@ -273,6 +273,11 @@ std::shared_ptr<ImplicitAssign> IRFragment::addImplicitAssign(const SharedExp &l
     }
 
     m_listOfRTLs->front()->append(newImplicit);
+
+    if (getProc()) {
+        getProc()->invalidateIRCaches();
+    }
+
     return newImplicit;
 }
 
@@ -282,7 +287,7 @@ std::shared_ptr<PhiAssign> IRFragment::addPhi(const SharedExp &usedExp)
     assert(m_listOfRTLs);
 
     if (m_listOfRTLs->empty() || m_listOfRTLs->front()->getAddress() != Address::ZERO) {
-        m_listOfRTLs->push_front(std::unique_ptr<RTL>(new RTL(Address::ZERO)));
+        m_listOfRTLs->insert(m_listOfRTLs->begin(), std::make_unique<RTL>(Address::ZERO));
     }
 
     // do not allow BB with 2 zero address RTLs
@@ -312,6 +317,11 @@ std::shared_ptr<PhiAssign> IRFragment::addPhi(const SharedExp &usedExp)
     }
 
     m_listOfRTLs->front()->append(phi);
+
+    if (getProc()) {
+        getProc()->invalidateIRCaches();
+    }
+
     return phi;
 }
 
@@ -319,7 +329,7 @@ std::shared_ptr<PhiAssign> IRFragment::addPhi(const SharedExp &usedExp)
 void IRFragment::clearPhis()
 {
     RTLIterator rit;
-    StatementList::iterator sit;
+    RTL::iterator sit;
     for (SharedStmt s = getFirstStmt(rit, sit); s; s = getNextStmt(rit, sit)) {
         if (!s->isPhi()) {
             continue;
@@ -361,6 +371,10 @@ void IRFragment::removeRTL(RTL *rtl)
     if (it != m_listOfRTLs->end()) {
         m_listOfRTLs->erase(it);
         updateAddresses();
+
+        if (getProc()) {
+            getProc()->invalidateIRCaches();
+        }
     }
 }
 
@@ -546,6 +560,11 @@ void IRFragment::simplify()
         for (auto &rtl : *m_listOfRTLs) {
             rtl->simplify();
         }
+
+        // simplifying may remove or replace statements
+        if (getProc()) {
+            getProc()->invalidateIRCaches();
+        }
     }
 
     if (isType(FragType::Twoway)) {
@@ -14,15 +14,15 @@
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/util/StatementList.h"
 
-#include <list>
 #include <memory>
+#include <vector>
 
 
 class BasicBlock;
 class ImplicitAssign;
 class PhiAssign;
 
-using RTLList   = std::list<std::unique_ptr<RTL>>;
+using RTLList   = std::vector<std::unique_ptr<RTL>>;
 using SharedExp = std::shared_ptr<Exp>;
 
 
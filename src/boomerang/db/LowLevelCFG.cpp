@@ -266,6 +266,21 @@ void LowLevelCFG::addEdge(BasicBlock *sourceBB, Address addr)
 }
 
 
+void LowLevelCFG::addCallEdge(Address callerAddr, Address calleeAddr)
+{
+    m_callEdges[callerAddr].insert(calleeAddr);
+}
+
+
+const std::set<Address> &LowLevelCFG::getCallees(Address callerAddr) const
+{
+    static const std::set<Address> noCallees;
+
+    auto it = m_callEdges.find(callerAddr);
+    return it != m_callEdges.end() ? it->second : noCallees;
+}
+
+
 bool LowLevelCFG::isWellFormed() const
 {
     for (const BasicBlock *bb : *this) {
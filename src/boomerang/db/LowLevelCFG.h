@@ -18,6 +18,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 
 
 class BasicBlock;
@@ -157,6 +158,14 @@ public:
      */
     void addEdge(BasicBlock *sourceBB, Address destAddr);
 
+    /// Record that the procedure starting at \p callerAddr calls
+    /// the procedure starting at \p calleeAddr.
+    void addCallEdge(Address callerAddr, Address calleeAddr);
+
+    /// \returns the start addresses of all procedures called by the procedure
+    /// starting at \p callerAddr
+    const std::set<Address> &getCallees(Address callerAddr) const;
+
     /**
      * Checks that all BBs are complete, and all out edges are valid.
      * Also checks that the ProcCFG does not contain interprocedural edges.
@@ -204,4 +213,7 @@ private:
     /// Maps start addresses to BasicBlocks. Note that at most one BasicBlock
     /// can start at a given address.
     BBStartMap m_bbStartMap;
+
+    /// Calls between procedures found during decoding, by start address of the caller
+    std::map<Address, std::set<Address>> m_callEdges;
 };
@@ -265,6 +265,10 @@ bool Prog::removeFunction(const QString &name)
 
     if (function) {
         function->removeFromModule();
+        if (!function->isLib()) {
+            m_entryProcs.remove(static_cast<UserProc *>(function));
+        }
+
         m_project->alertFunctionRemoved(function);
         // FIXME: this function removes the function from module, but it leaks it
         return true;
@@ -629,7 +633,11 @@ bool Prog::decodeEntryPoint(Address entryAddr)
     }
 
     if (!func->isLib()) { // -sf procs marked as __nodecode are treated as library procs (?)
-        m_entryProcs.push_back(static_cast<UserProc *>(func));
+        UserProc *proc = static_cast<UserProc *>(func);
+
+        if (std::find(m_entryProcs.begin(), m_entryProcs.end(), proc) == m_entryProcs.end()) {
+            m_entryProcs.push_back(proc);
+        }
     }
 
     return true;
@@ -77,6 +77,11 @@ public:
     LowLevelCFG *getCFG() { return m_cfg.get(); }
     const LowLevelCFG *getCFG() const { return m_cfg.get(); }
 
+    /// Changed whenever a failed proof of any procedure might succeed now.
+    /// \sa UserProc::invalidateFailedProofs
+    uint64 getProofGeneration() const { return m_proofGeneration; }
+    void incProofGeneration() { m_proofGeneration++; }
+
     /**
      * Creates a new empty module.
      * \param name   The name of the new module.
@@ -135,7 +140,7 @@ public:
     /// or nullptr if no such function exists.
     Function *getFunctionByName(const QString &name) const;
 
-    /// Removes the function with name \p name.
+    /// Removes the function with name \p name, also from the entry procedures.
     /// If there is no such function, nothing happens.
     /// \returns true if function was found and removed.
     bool removeFunction(const QString &name);
@@ -258,6 +263,8 @@ private:
 
     std::unique_ptr<LowLevelCFG> m_cfg;
 
+    uint64 m_proofGeneration = 0; ///< \sa getProofGeneration
+
     /// list of UserProcs for entry point(s)
     std::list<UserProc *> m_entryProcs;
 
@@ -13,6 +13,16 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/visitor/expmodifier/ExpSSAXformer.h"
 
+#include <cassert>
+
+
+/// The locations of empty collectors. Must stay empty.
+static LocationSet &noLocs()
+{
+    static LocationSet locs;
+    return locs;
+}
+
 
 UseCollector::UseCollector()
 {
@@ -24,14 +34,41 @@ UseCollector::~UseCollector()
 }
 
 
+UseCollector::iterator UseCollector::begin()
+{
+    if (!m_locs) {
+        return noLocs().begin();
+    }
+
+    return getWritableLocs().begin();
+}
+
+
+UseCollector::iterator UseCollector::end()
+{
+    if (!m_locs) {
+        return noLocs().end();
+    }
+
+    return getWritableLocs().end();
+}
+
+
 bool UseCollector::operator==(const UseCollector &other) const
 {
-    if (other.m_locs.size() != m_locs.size()) {
+    if (m_locs == other.m_locs) {
+        return true; // shared or both empty
+    }
+
+    const LocationSet &locs      = getUses();
+    const LocationSet &otherLocs = other.getUses();
+
+    if (otherLocs.size() != locs.size()) {
         return false;
     }
 
-    iterator it1, it2;
-    for (it1 = m_locs.begin(), it2 = other.m_locs.begin(); it1 != m_locs.end(); ++it1, ++it2) {
+    const_iterator it1, it2;
+    for (it1 = locs.begin(), it2 = otherLocs.begin(); it1 != locs.end(); ++it1, ++it2) {
         if (!(**it1 == **it2)) {
             return false;
         }
@@ -43,36 +80,51 @@ bool UseCollector::operator==(const UseCollector &other) const
 
 void UseCollector::makeCloneOf(const UseCollector &other)
 {
-    m_locs.clear();
-
-    for (auto const &elem : other) {
-        m_locs.insert((elem)->clone());
+    if (other.m_locs && !other.m_locs->empty()) {
+        m_locs = other.m_locs;
     }
+    else {
+        m_locs = nullptr;
+    }
+}
+
+
+bool UseCollector::isSharedWith(const UseCollector &other) const
+{
+    return m_locs != nullptr && m_locs == other.m_locs;
 }
 
 
 void UseCollector::clear()
 {
-    m_locs.clear();
+    m_locs = nullptr;
 }
 
 
 void UseCollector::collectUse(SharedExp e)
 {
-    m_locs.insert(e);
+    if (!hasUse(e)) {
+        getWritableLocs().insert(e);
+    }
+}
+
+
+const LocationSet &UseCollector::getUses() const
+{
+    return m_locs ? *m_locs : noLocs();
 }
 
 
 void UseCollector::print(OStream &os) const
 {
-    if (m_locs.empty()) {
+    if (getUses().empty()) {
         os << "<None>";
         return;
     }
 
     bool first = true;
 
-    for (auto const &elem : m_locs) {
+    for (auto const &elem : getUses()) {
         if (first) {
             first = false;
         }
@@ -87,11 +139,16 @@ void UseCollector::print(OStream &os) const
 
 void UseCollector::fromSSAForm(UserProc *proc, const SharedStmt &def)
 {
+    if (!m_locs) {
+        return;
+    }
+
     LocationSet removes, inserts;
     iterator it;
     ExpSSAXformer esx(proc);
+    LocationSet &locs = getWritableLocs();
 
-    for (it = m_locs.begin(); it != m_locs.end(); ++it) {
+    for (it = locs.begin(); it != locs.end(); ++it) {
         auto ref      = RefExp::get(*it, def); // Wrap it in a def
         SharedExp ret = ref->acceptModifier(&esx);
 
@@ -105,22 +162,40 @@ void UseCollector::fromSSAForm(UserProc *proc, const SharedStmt &def)
     }
 
     for (it = removes.begin(); it != removes.end(); ++it) {
-        m_locs.remove(*it);
+        locs.remove(*it);
     }
 
     for (it = inserts.begin(); it != inserts.end(); ++it) {
-        m_locs.insert(*it);
+        locs.insert(*it);
     }
 }
 
 
 void UseCollector::removeUse(SharedExp loc)
 {
-    m_locs.remove(loc);
+    if (hasUse(loc)) {
+        getWritableLocs().remove(loc);
+    }
 }
 
 
 UseCollector::iterator UseCollector::removeUse(UseCollector::iterator it)
 {
-    return m_locs.erase(it);
+    // it must point into the locations of this collector only
+    assert(m_locs.use_count() == 1);
+    return m_locs->erase(it);
+}
+
+
+LocationSet &UseCollector::getWritableLocs()
+{
+    if (!m_locs) {
+        m_locs = std::make_shared<LocationSet>();
+    }
+    else if (m_locs.use_count() > 1) {
+        // Shared with another collector; LocationSet's copy constructor clones the locations
+        m_locs = std::make_shared<LocationSet>(*m_locs);
+    }
+
+    return *m_locs;
 }
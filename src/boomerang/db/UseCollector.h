@@ -13,6 +13,8 @@
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/util/LocationSet.h"
 
+#include <memory>
+
 
 class UserProc;
 
@@ -23,6 +25,9 @@ class UserProc;
  *
  * Typically the entries are not subscripted,
  * like parameters or locations on the LHS of assignments
+ *
+ * Like \ref DefCollector, collectors cloned from each other share their locations
+ * until one of them is modified.
  */
 class BOOMERANG_API UseCollector
 {
@@ -44,15 +49,21 @@ public:
     bool operator==(const UseCollector &other) const;
     bool operator!=(const UseCollector &other) const { return !(*this == other); }
 
-    inline iterator begin() { return m_locs.begin(); }
-    inline iterator end() { return m_locs.end(); }
-    inline const_iterator begin() const { return m_locs.begin(); }
-    inline const_iterator end() const { return m_locs.end(); }
+    /// Non-const iteration clones shared locations first,
+    /// but does not allocate locations for an empty collector.
+    iterator begin();
+    iterator end();
+    inline const_iterator begin() const { return getUses().begin(); }
+    inline const_iterator end() const { return getUses().end(); }
 
 public:
-    /// clone the given Collector into this one (discard existing data)
+    /// clone the given Collector into this one (discard existing data).
+    /// The locations are shared with \p other until either collector is modified.
     void makeCloneOf(const UseCollector &other);
 
+    /// \returns true if this collector shares its locations with \p other
+    bool isSharedWith(const UseCollector &other) const;
+
     /// Remove all collected uses
     void clear();
 
@@ -60,16 +71,17 @@ public:
     void collectUse(SharedExp e);
 
     /// \returns true if \p e is in the collection
-    inline bool hasUse(SharedExp e) const { return m_locs.contains(e); }
+    inline bool hasUse(SharedExp e) const { return m_locs && m_locs->contains(e); }
 
     /// Remove the given location
     void removeUse(SharedExp loc);
 
-    /// Remove the current location
+    /// Remove the current location. \p it must have been obtained from the non-const \ref begin
+    /// after the last time this collector was cloned.
     iterator removeUse(iterator it);
 
     /// \return all collected uses
-    const LocationSet &getUses() const { return m_locs; }
+    const LocationSet &getUses() const;
 
 public:
     /// Translate out of SSA form
@@ -80,6 +92,12 @@ public:
     void print(OStream &os) const;
 
 private:
-    /// The set of locations. Use lessExpStar to compare properly
-    LocationSet m_locs;
+    /// \returns the locations for modification. Clones the locations first
+    /// if they are shared with another collector.
+    LocationSet &getWritableLocs();
+
+private:
+    /// The set of locations, or nullptr if there are none. Use lessExpStar to compare properly.
+    /// Shared between collectors cloned from each other until one of them is modified.
+    std::shared_ptr<LocationSet> m_locs;
 };
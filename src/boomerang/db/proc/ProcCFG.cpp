@@ -35,16 +35,17 @@ ProcCFG::ProcCFG(UserProc *proc)
 
 ProcCFG::~ProcCFG()
 {
-    clear();
+    // Do not invalidate the caches of the proc here; they might already be destroyed.
+    deleteFragments();
 }
 
 
 void ProcCFG::clear()
 {
-    m_implicitMap.clear();
+    deleteFragments();
 
-    qDeleteAll(begin(), end()); // deletes all fragments
-    m_fragmentSet.clear();
+    // the statement index and the proof cache may refer to deleted statements
+    m_myProc->invalidateIRCaches();
 }
 
 
@@ -65,6 +66,7 @@ IRFragment *ProcCFG::createFragment(FragType fragType, std::unique_ptr<RTLList>
 
     IRFragment *frag = new IRFragment(getNextFragID(), bb, std::move(rtls));
     m_fragmentSet.insert(frag);
+    m_myProc->invalidateIRCaches();
 
     frag->setType(fragType);
     frag->updateAddresses();
@@ -93,6 +95,7 @@ IRFragment *ProcCFG::splitFragment(IRFragment *frag, Address splitAddr)
     std::for_each(it, frag->getRTLs()->end(),
                   [&newRTLs](std::unique_ptr<RTL> &rtl) { newRTLs->push_back(std::move(rtl)); });
     frag->getRTLs()->erase(it, frag->getRTLs()->end());
+    m_myProc->invalidateIRCaches();
 
     IRFragment *newFrag = createFragment(frag->getType(), std::move(newRTLs), frag->getBB());
     frag->setType(FragType::Fall);
@@ -112,7 +115,7 @@ void ProcCFG::removeFragment(IRFragment *frag)
     assert(this->hasFragment(frag));
 
     RTLList::iterator rit;
-    StatementList::iterator sit;
+    RTL::iterator sit;
 
     for (SharedStmt s = frag->getFirstStmt(rit, sit); s; s = frag->getNextStmt(rit, sit)) {
         if (s->isCall()) {
@@ -149,6 +152,7 @@ void ProcCFG::removeFragment(IRFragment *frag)
 
     assert(*it == frag);
     m_fragmentSet.erase(it);
+    m_myProc->invalidateIRCaches();
     delete frag;
 }
 
@@ -352,6 +356,15 @@ void ProcCFG::setEntryAndExitFragment(IRFragment *entryFrag)
 }
 
 
+void ProcCFG::deleteFragments()
+{
+    m_implicitMap.clear();
+
+    qDeleteAll(begin(), end()); // deletes all fragments
+    m_fragmentSet.clear();
+}
+
+
 ProcCFG::FragmentSet::iterator ProcCFG::findFragment(const IRFragment *frag) const
 {
     auto [from, to] = m_fragmentSet.equal_range(const_cast<IRFragment *>(frag));
@@ -18,10 +18,10 @@
 #include "boomerang/util/MapIterators.h"
 #include "boomerang/util/Util.h"
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 
 class Function;
@@ -30,7 +30,7 @@ class BasicBlock;
 class RTL;
 class Parameter;
 
-using RTLList = std::list<std::unique_ptr<RTL>>;
+using RTLList = std::vector<std::unique_ptr<RTL>>;
 
 enum class BBType;
 
@@ -154,6 +154,9 @@ public:
     QString toString() const;
 
 private:
+    /// Delete all fragments without notifying the proc.
+    void deleteFragments();
+
     FragmentSet::iterator findFragment(const IRFragment *frag) const;
 
     IRFragment::FragID getNextFragID() const { return m_nextID++; }
@@ -0,0 +1,78 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StatementRange.h"
+
+#include "boomerang/db/IRFragment.h"
+
+
+StatementIterator::StatementIterator(ProcCFG::const_iterator fragIt,
+                                     ProcCFG::const_iterator fragEnd)
+    : m_fragIt(fragIt)
+    , m_fragEnd(fragEnd)
+{
+    skipEmpty(true);
+}
+
+
+bool StatementIterator::operator==(const StatementIterator &other) const
+{
+    if (m_fragIt != other.m_fragIt) {
+        return false;
+    }
+
+    // all end iterators are equal
+    return m_fragIt == m_fragEnd || (m_rtlIt == other.m_rtlIt && m_stmtIt == other.m_stmtIt);
+}
+
+
+StatementIterator &StatementIterator::operator++()
+{
+    ++m_stmtIt;
+    skipEmpty(false);
+    return *this;
+}
+
+
+StatementIterator StatementIterator::operator++(int)
+{
+    StatementIterator it = *this;
+    ++(*this);
+    return it;
+}
+
+
+void StatementIterator::skipEmpty(bool newFragment)
+{
+    while (m_fragIt != m_fragEnd) {
+        const RTLList *rtls = (*m_fragIt)->getRTLs();
+
+        if (rtls) {
+            if (newFragment) {
+                m_rtlIt = rtls->begin();
+                if (m_rtlIt != rtls->end()) {
+                    m_stmtIt = (*m_rtlIt)->begin();
+                }
+            }
+
+            while (m_rtlIt != rtls->end()) {
+                if (m_stmtIt != (*m_rtlIt)->end()) {
+                    return; // found a statement
+                }
+
+                if (++m_rtlIt != rtls->end()) {
+                    m_stmtIt = (*m_rtlIt)->begin();
+                }
+            }
+        }
+
+        ++m_fragIt;
+        newFragment = true;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/proc/ProcCFG.h"
+
+#include <iterator>
+
+
+/**
+ * Iterates over all statements of a procedure in place, fragment by fragment and RTL by RTL,
+ * skipping empty RTLs and fragments.
+ *
+ * The iterator is invalidated when fragments or RTLs are added to or removed from the procedure,
+ * or when statements are inserted into or removed from an RTL.
+ */
+class BOOMERANG_API StatementIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef SharedStmt value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const SharedStmt *pointer;
+    typedef const SharedStmt &reference;
+
+public:
+    /// Creates an iterator pointing to the first statement in [\p fragIt, \p fragEnd)
+    StatementIterator(ProcCFG::const_iterator fragIt, ProcCFG::const_iterator fragEnd);
+
+    bool operator==(const StatementIterator &other) const;
+    bool operator!=(const StatementIterator &other) const { return !(*this == other); }
+
+    reference operator*() const { return *m_stmtIt; }
+    pointer operator->() const { return &*m_stmtIt; }
+
+    StatementIterator &operator++();
+    StatementIterator operator++(int);
+
+private:
+    /// Advance to the first statement at or after the current position.
+    /// \param newFragment true if the current position is the start of the current fragment
+    void skipEmpty(bool newFragment);
+
+private:
+    ProcCFG::const_iterator m_fragIt;
+    ProcCFG::const_iterator m_fragEnd;
+    RTLList::const_iterator m_rtlIt = {};
+    RTL::const_iterator m_stmtIt    = {};
+};
+
+
+/// All statements of a procedure, without copying them. \sa StatementIterator
+class BOOMERANG_API StatementRange
+{
+public:
+    typedef StatementIterator iterator;
+    typedef StatementIterator const_iterator;
+
+public:
+    explicit StatementRange(const ProcCFG *cfg)
+        : m_cfg(cfg)
+    {
+    }
+
+    iterator begin() const { return iterator(m_cfg->begin(), m_cfg->end()); }
+    iterator end() const { return iterator(m_cfg->end(), m_cfg->end()); }
+
+    bool empty() const { return begin() == end(); }
+
+private:
+    const ProcCFG *m_cfg;
+};
@@ -138,7 +138,7 @@ void UserProc::numberStatements() const
 
     for (IRFragment *frag : *m_cfg) {
         IRFragment::RTLIterator rit;
-        StatementList::iterator sit;
+        RTL::iterator sit;
         for (SharedStmt s = frag->getFirstStmt(rit, sit); s; s = frag->getNextStmt(rit, sit)) {
             s->setNumber(++stmtNumber);
         }
@@ -160,6 +160,27 @@ void UserProc::getStatements(StatementList &stmts) const
 }
 
 
+std::shared_ptr<const UserProc::StatementIndex> UserProc::getStatementIndex() const
+{
+    if (m_stmtIndex) {
+        return m_stmtIndex;
+    }
+
+    std::shared_ptr<StatementIndex> index = std::make_shared<StatementIndex>();
+
+    for (const SharedStmt &s : getStatementRange()) {
+        if (s->getProc() == nullptr) {
+            s->setProc(const_cast<UserProc *>(this));
+        }
+
+        index->push_back(s);
+    }
+
+    m_stmtIndex = index;
+    return m_stmtIndex;
+}
+
+
 bool UserProc::removeStatement(const SharedStmt &stmt)
 {
     if (!stmt) {
@@ -182,6 +203,7 @@ bool UserProc::removeStatement(const SharedStmt &stmt)
                         provenIt->first, provenIt->second);
 
             provenIt = m_provenTrue.erase(provenIt);
+            clearProofCache();
             continue;
         }
 
@@ -198,6 +220,7 @@ bool UserProc::removeStatement(const SharedStmt &stmt)
         for (RTL::iterator it = rtl->begin(); it != rtl->end(); ++it) {
             if (*it == stmt) {
                 rtl->erase(it);
+                invalidateIRCaches();
                 return true;
             }
         }
@@ -232,12 +255,15 @@ std::shared_ptr<Assign> UserProc::insertAssignAfter(SharedStmt s, SharedExp left
             for (auto it = rtl->begin(); it != rtl->end(); ++it) {
                 if (*it == s) {
                     rtl->insert(++it, as);
+                    invalidateIRCaches();
                     return as;
                 }
             }
         }
     }
 
+    invalidateIRCaches();
+
     auto &lastRTL = frag->getRTLs()->back();
     if (lastRTL->empty() || lastRTL->back()->isAssignment()) {
         lastRTL->append(as);
@@ -264,6 +290,7 @@ bool UserProc::insertStatementAfter(const SharedStmt &afterThis, const SharedStm
             if (*ss == afterThis) {
                 rtl->insert(std::next(ss), stmt);
                 stmt->setFragment(frag);
+                invalidateIRCaches();
                 return true;
             }
         }
@@ -300,12 +327,10 @@ std::shared_ptr<Assign> UserProc::replacePhiByAssign(const std::shared_ptr<const
                         ++ss;
                     }
                     rtl->insert(ss, asgn);
-
-                    StatementList stmts;
-                    getStatements(stmts);
+                    invalidateIRCaches();
 
                     // replace all refs orig -> asgn
-                    for (const SharedStmt &stmt : stmts) {
+                    for (const SharedStmt &stmt : getStatementRange()) {
                         StmtSubscriptReplacer stmtMod(orig, asgn);
 
                         stmt->accept(&stmtMod);
@@ -843,7 +868,7 @@ void UserProc::markAsNonChildless(const std::shared_ptr<ProcSet> &cs)
     assert(cs);
 
     IRFragment::RTLRIterator rrit;
-    StatementList::reverse_iterator srit;
+    RTL::reverse_iterator srit;
 
     for (IRFragment *frag : *m_cfg) {
         SharedStmt s = frag->getLastStmt(rrit, srit);
@@ -910,13 +935,15 @@ QString UserProc::findFirstSymbol(const SharedConstExp &exp) const
 bool UserProc::searchAndReplace(const Exp &search, SharedExp replace)
 {
     bool ch = false;
-    StatementList stmts;
-    getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : getStatementRange()) {
         ch |= s->searchAndReplace(search, replace);
     }
 
+    if (ch) {
+        invalidateIRCaches();
+    }
+
     return ch;
 }
 
@@ -929,10 +956,7 @@ void UserProc::markAsInitialParam(const SharedExp &loc)
 
 bool UserProc::allPhisHaveDefs() const
 {
-    StatementList stmts;
-    getStatements(stmts);
-
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : getStatementRange()) {
         if (!stmt->isPhi()) {
             continue; // Might be able to optimise this a bit
         }
@@ -1172,7 +1196,135 @@ SharedConstType UserProc::getTypeForLocation(const SharedConstExp &e) const
 static const SharedExp defAll = Terminal::get(opDefineAll);
 
 
+/// Compare two (possibly null) expressions like \ref lessExpStar
+static int compareExps(const SharedConstExp &left, const SharedConstExp &right)
+{
+    if (!left || !right) {
+        return (left != nullptr) - (right != nullptr);
+    }
+
+    return lessExpStar()(left, right) ? -1 : (lessExpStar()(right, left) ? 1 : 0);
+}
+
+
+bool UserProc::ProofCacheKey::operator<(const ProofCacheKey &other) const
+{
+    if (conditional != other.conditional) {
+        return conditional < other.conditional;
+    }
+    else if (premises.size() != other.premises.size()) {
+        return premises.size() < other.premises.size();
+    }
+
+    int cmp = compareExps(left, other.left);
+    if (cmp == 0) {
+        cmp = compareExps(right, other.right);
+    }
+
+    for (std::size_t i = 0; cmp == 0 && i < premises.size(); ++i) {
+        const auto &[proc, premLeft, premRight]                = premises[i];
+        const auto &[otherProc, otherPremLeft, otherPremRight] = other.premises[i];
+
+        if (proc != otherProc) {
+            return proc < otherProc;
+        }
+
+        cmp = compareExps(premLeft, otherPremLeft);
+        if (cmp == 0) {
+            cmp = compareExps(premRight, otherPremRight);
+        }
+    }
+
+    return cmp < 0;
+}
+
+
 bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRight, bool conditional)
+{
+    Profiler *profiler = m_prog->getProject()->getProfiler();
+
+    auto cacheIt = m_proofCache.find(getProofCacheKey(queryLeft, queryRight, conditional, false));
+
+    if (cacheIt != m_proofCache.end() &&
+        (cacheIt->second.result || cacheIt->second.generation == m_prog->getProofGeneration())) {
+        profiler->addToCounter("proofCacheHits");
+
+        if (m_prog->getProject()->getSettings()->debugProof) {
+            LOG_MSG("found %1 in proof cache %2 in %3", cacheIt->second.result ? "true" : "false",
+                    Binary::get(opEquals, queryLeft, queryRight), getName());
+        }
+
+        return cacheIt->second.result;
+    }
+
+    profiler->addToCounter("proofCacheMisses");
+
+    // Build the key before the proof, which adds premises temporarily.
+    ProofCacheKey cacheKey = getProofCacheKey(queryLeft, queryRight, conditional, true);
+    const bool result      = proveEqualUncached(queryLeft, queryRight, conditional);
+
+    // Note: Use the generation after the proof, since the proof itself
+    // might have proven something new.
+    m_proofCache[std::move(cacheKey)] = { result, m_prog->getProofGeneration() };
+    return result;
+}
+
+
+UserProc::ProofCacheKey UserProc::getProofCacheKey(const SharedExp &lhs, const SharedExp &rhs,
+                                                   bool conditional, bool clone) const
+{
+    ProofCacheKey key;
+    key.left        = clone ? lhs->clone() : lhs;
+    key.right       = clone ? rhs->clone() : rhs;
+    key.conditional = conditional;
+
+    if (m_recursionGroup) {
+        for (const UserProc *proc : *m_recursionGroup) {
+            for (const auto &[left, right] : proc->m_recurPremises) {
+                key.premises.emplace_back(proc, clone ? left->clone() : left,
+                                          clone ? right->clone() : right);
+            }
+        }
+    }
+
+    return key;
+}
+
+
+void UserProc::clearProofCache()
+{
+    if (m_proofCache.empty()) {
+        // Nothing was proven since the last time; failed proofs of callers
+        // cannot depend on anything cached here.
+        return;
+    }
+
+    m_proofCache.clear();
+
+    // Failed proofs of callers might have used results of this procedure
+    invalidateFailedProofs();
+}
+
+
+void UserProc::invalidateFailedProofs()
+{
+    // Note: A single counter for the whole program is cheaper than finding
+    // all procedures whose failed proofs might be affected.
+    if (m_prog) {
+        m_prog->incProofGeneration();
+    }
+}
+
+
+void UserProc::invalidateIRCaches()
+{
+    invalidateStatementIndex();
+    clearProofCache();
+}
+
+
+bool UserProc::proveEqualUncached(const SharedExp &queryLeft, const SharedExp &queryRight,
+                                  bool conditional)
 {
     if ((m_provenTrue.find(queryLeft) != m_provenTrue.end()) &&
         (*m_provenTrue[queryLeft] == *queryRight)) {
@@ -1225,6 +1377,7 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
                 }
 
                 m_provenTrue[origLeft->clone()] = right;
+                invalidateFailedProofs();
                 return true;
             }
 
@@ -1257,6 +1410,7 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
 
     if (result && !conditional) {
         m_provenTrue[origLeft] = origRight; // Save the now proven equation
+        invalidateFailedProofs();
     }
 
     return result;
@@ -1540,10 +1694,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
             // find a memory def for the right if there is a memof on the left
             // FIXME: this seems pretty much like a bad hack!
             if (!change && query->getSubExp1()->isMemOf()) {
-                StatementList stmts;
-                getStatements(stmts);
-
-                for (SharedStmt s : stmts) {
+                for (const SharedStmt &s : getStatementRange()) {
                     std::shared_ptr<Assign> as = std::dynamic_pointer_cast<Assign>(s);
 
                     if (as && (*as->getRight() == *query->getSubExp2()) &&
@@ -14,8 +14,13 @@
 #include "boomerang/db/UseCollector.h"
 #include "boomerang/db/proc/Proc.h"
 #include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/StatementRange.h"
 #include "boomerang/util/StatementList.h"
 
+#include <chrono>
+#include <tuple>
+#include <vector>
+
 
 class Binary;
 class UserProc;
@@ -68,6 +73,9 @@ public:
      */
     typedef std::multimap<SharedConstExp, SharedExp, lessExpStar> SymbolMap;
 
+    /// All statements of a procedure in the order of \ref getStatementRange
+    typedef std::vector<SharedStmt> StatementIndex;
+
 public:
     /**
      * \param address Address of entry point of function
@@ -121,6 +129,24 @@ public:
     /// Records that this procedure has been decoded.
     void setDecoded();
 
+    /// \returns true if the decompilation of this procedure exceeded its time or pass budget
+    /// and was finished with a reduced pipeline.
+    bool isDegraded() const { return m_degraded; }
+    void setDegraded(bool degraded) { m_degraded = degraded; }
+
+    /// Account for a pass executed for this procedure which took \p time to execute.
+    void addPassCost(std::chrono::steady_clock::duration time)
+    {
+        m_numExecutedPasses++;
+        m_passTime += time;
+    }
+
+    /// \returns the number of passes executed for this procedure so far
+    int getNumExecutedPasses() const { return m_numExecutedPasses; }
+
+    /// \returns the total time spent executing passes for this procedure so far
+    std::chrono::steady_clock::duration getPassTime() const { return m_passTime; }
+
     bool isEarlyRecursive() const
     {
         return m_recursionGroup != nullptr && m_status <= ProcStatus::InCycle;
@@ -151,6 +177,28 @@ public:
     /// \returns all statements in this UserProc
     void getStatements(StatementList &stmts) const;
 
+    /**
+     * \returns all statements in this UserProc without copying them.
+     * Use this for loops that do not add or remove statements, fragments or RTLs.
+     */
+    StatementRange getStatementRange() const { return StatementRange(m_cfg.get()); }
+
+    /**
+     * \returns all statements in this UserProc. The index is built on first use and shared
+     * until statements, fragments or RTLs are added or removed, so it can be iterated
+     * while the procedure is modified. Keep the returned pointer alive while iterating.
+     */
+    std::shared_ptr<const StatementIndex> getStatementIndex() const;
+
+    /// Discard the cached statement index. Must be called after adding or removing
+    /// statements or RTLs without using the functions of UserProc, ProcCFG or IRFragment.
+    void invalidateStatementIndex() { m_stmtIndex = nullptr; }
+
+    /// Discard everything cached about the IR of this procedure,
+    /// i.e. the statement index and the results of previous proofs.
+    /// Called whenever statements, RTLs or fragments are added or removed.
+    void invalidateIRCaches();
+
     /// Remove (but not delete) \p stmt from this UserProc
     /// \returns true iff successfully removed
     bool removeStatement(const SharedStmt &stmt);
@@ -331,6 +379,10 @@ public:
 
     const ExpExpMap &getProvenTrue() const { return m_provenTrue; }
 
+    /// Forget all cached results of \ref proveEqual for this procedure.
+    /// Must be called whenever the SSA form of this procedure changes.
+    void clearProofCache();
+
 public:
     QString toString() const;
 
@@ -368,6 +420,15 @@ private:
     /// \note this function was non-reentrant, but now reentrancy is frequently used
     bool proveEqual(const SharedExp &lhs, const SharedExp &rhs, bool conditional = false);
 
+    /// \copydoc proveEqual
+    /// Does not use or update the proof cache.
+    bool proveEqualUncached(const SharedExp &lhs, const SharedExp &rhs, bool conditional);
+
+    /// Make failed proofs of all procedures be retried, since they might succeed now.
+    /// A failed proof of any caller or recursion group member might depend on
+    /// what was just proven or changed here.
+    void invalidateFailedProofs();
+
     /// helper function for proveEqual()
     bool prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &lastPhis,
                 std::map<std::shared_ptr<PhiAssign>, SharedExp> &cache,
@@ -391,11 +452,18 @@ private:
     /// Status: undecoded .. final decompiled
     ProcStatus m_status = ProcStatus::Undecoded;
 
+    bool m_degraded         = false; ///< See \ref isDegraded
+    int m_numExecutedPasses = 0;
+    std::chrono::steady_clock::duration m_passTime = std::chrono::steady_clock::duration::zero();
+
     /// Number of the next local. Can't use locals.size() because some get deleted
     uint32 m_nextLocal = 0;
 
     std::unique_ptr<ProcCFG> m_cfg; ///< The control flow graph.
 
+    /// Cached result of \ref getStatementIndex, or nullptr if it needs to be rebuilt.
+    mutable std::shared_ptr<const StatementIndex> m_stmtIndex;
+
     /// DataFlow object. Holds information relevant to transforming to and from SSA form.
     DataFlow m_df;
 
@@ -453,6 +521,42 @@ private:
      */
     ExpExpMap m_recurPremises;
 
+    /**
+     * Key of a cached proof. Expressions are compared like \ref lessExpStar,
+     * so subscripts are told apart by their definitions.
+     * Since proofs in recursion groups depend on the premises of all procedures in the group,
+     * these are part of the key.
+     */
+    struct ProofCacheKey
+    {
+        SharedConstExp left;
+        SharedConstExp right;
+        bool conditional;
+        std::vector<std::tuple<const UserProc *, SharedConstExp, SharedConstExp>> premises;
+
+        bool operator<(const ProofCacheKey &other) const;
+    };
+
+    /// Result of a cached proof.
+    struct ProofCacheEntry
+    {
+        bool result;       ///< true if the query was proven
+        uint64 generation; ///< Value of Prog::getProofGeneration when the proof failed
+    };
+
+    /// \returns the key of a query in the proof cache.
+    /// \param clone Clone all expressions, so the key stays valid when they are modified.
+    ProofCacheKey getProofCacheKey(const SharedExp &lhs, const SharedExp &rhs, bool conditional,
+                                   bool clone) const;
+
+    /**
+     * Results of previous proofs.
+     * Successful proofs stay valid until the IR of this procedure changes.
+     * Failed proofs are only valid while Prog::getProofGeneration is unchanged,
+     * since a failed proof might succeed with more information about callees.
+     */
+    std::map<ProofCacheKey, ProofCacheEntry> m_proofCache;
+
     std::shared_ptr<ProcSet> m_recursionGroup;
 
     /**
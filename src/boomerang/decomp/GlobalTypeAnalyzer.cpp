@@ -0,0 +1,313 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "GlobalTypeAnalyzer.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/ssl/type/Type.h"
+#include "boomerang/util/log/Log.h"
+
+#include <algorithm>
+#include <chrono>
+
+
+/// Maximum number of times a single procedure is analyzed during one run
+#define GLOBAL_TA_ITER_LIMIT (10)
+
+
+GlobalTypeAnalyzer::GlobalTypeAnalyzer(Prog *prog)
+    : m_prog(prog)
+{
+}
+
+
+void GlobalTypeAnalyzer::analyzeTypes()
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    m_numAnalyzed.clear();
+
+    // Only keep the types of procedures that still exist
+    std::map<UserProc *, InterfaceTypes> oldTypes;
+    std::swap(oldTypes, m_analyzedTypes);
+
+    int numProcs = 0;
+
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (func->isLib() || !static_cast<UserProc *>(func)->isDecoded()) {
+                continue;
+            }
+
+            UserProc *proc = static_cast<UserProc *>(func);
+            numProcs++;
+
+            auto it = oldTypes.find(proc);
+            if (it != oldTypes.end() && isSameInterface(it->second, getInterfaceTypes(proc))) {
+                m_analyzedTypes[proc] = std::move(it->second);
+                continue; // nothing changed since the last analysis
+            }
+
+            // Not analyzed yet, or the interface was changed by some other analysis
+            // (e.g. by removing unused returns). Since we do not know which types changed,
+            // schedule all neighbours in the call graph as well.
+            m_workSet.insert(proc);
+            scheduleCallers(proc);
+
+            for (const std::shared_ptr<CallStatement> &call : getUserCalls(proc)) {
+                m_workSet.insert(static_cast<UserProc *>(call->getDestProc()));
+            }
+        }
+    }
+
+    int numIterations = 0;
+
+    // Process the worklist in order of entry address to get deterministic results.
+    while (!m_workSet.empty()) {
+        UserProc *proc = *m_workSet.begin();
+        m_workSet.erase(m_workSet.begin());
+
+        if (m_numAnalyzed[proc]++ >= GLOBAL_TA_ITER_LIMIT) {
+            LOG_VERBOSE("Iteration limit exceeded for global type analysis of procedure '%1'",
+                        proc->getName());
+            continue;
+        }
+
+        numIterations++;
+        analyzeProc(proc);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+
+    LOG_MSG("Global type analysis: Analyzed %1 of %2 procedures in %3 iterations (%4 ms)",
+            m_numAnalyzed.size(), numProcs, numIterations, elapsed.count());
+}
+
+
+int GlobalTypeAnalyzer::getNumAnalyzed(UserProc *proc) const
+{
+    auto it = m_numAnalyzed.find(proc);
+    return it != m_numAnalyzed.end() ? it->second : 0;
+}
+
+
+void GlobalTypeAnalyzer::analyzeProc(UserProc *proc)
+{
+    const bool debugTA                  = m_prog->getProject()->getSettings()->debugTA;
+    const InterfaceTypes oldReturnTypes = getReturnTypes(proc);
+
+    LOG_VERBOSE("Global type analysis for '%1'", proc->getName());
+
+    if (meetResultTypes(proc) && debugTA) {
+        LOG_VERBOSE("Types of call results in '%1' changed", proc->getName());
+    }
+
+    if (!proc->isDegraded()) {
+        PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+    }
+
+    meetArgumentTypes(proc);
+
+    if (!isSameInterface(getReturnTypes(proc), oldReturnTypes)) {
+        if (debugTA) {
+            LOG_VERBOSE("Return types of '%1' changed", proc->getName());
+        }
+
+        scheduleCallers(proc);
+    }
+
+    m_analyzedTypes[proc] = getInterfaceTypes(proc);
+}
+
+
+bool GlobalTypeAnalyzer::meetResultTypes(UserProc *proc)
+{
+    bool changed = false;
+
+    for (const std::shared_ptr<CallStatement> &call : getUserCalls(proc)) {
+        UserProc *callee = static_cast<UserProc *>(call->getDestProc());
+
+        if (!callee->getRetStmt()) {
+            continue;
+        }
+
+        for (SharedStmt ret : callee->getRetStmt()->getReturns()) {
+            if (!ret->isAssignment()) {
+                continue;
+            }
+
+            std::shared_ptr<Assignment> retDef = ret->as<Assignment>();
+
+            // Only meet with locations that are actually defined by the call;
+            // otherwise the type would be set for a reaching definition instead.
+            if (!call->getDefines().findOnLeft(retDef->getLeft())) {
+                continue;
+            }
+
+            call->meetWithFor(retDef->getType(), retDef->getLeft(), changed);
+        }
+    }
+
+    return changed;
+}
+
+
+void GlobalTypeAnalyzer::meetArgumentTypes(UserProc *proc)
+{
+    for (const std::shared_ptr<CallStatement> &call : getUserCalls(proc)) {
+        UserProc *callee = static_cast<UserProc *>(call->getDestProc());
+
+        if (callee->getSignature()->isForced()) {
+            continue; // Do not override user-specified types
+        }
+
+        bool calleeChanged = false;
+
+        for (SharedStmt arg : call->getArguments()) {
+            if (!arg->isAssign()) {
+                continue;
+            }
+
+            std::shared_ptr<Assign> argDef = arg->as<Assign>();
+            const int paramIdx             = callee->getSignature()->findParam(argDef->getLeft());
+
+            if (paramIdx == -1) {
+                continue;
+            }
+
+            bool thisCh           = false;
+            SharedType paramType  = callee->getSignature()->getParamType(paramIdx);
+            const SharedType meet = paramType->meetWith(argDef->getType(), thisCh);
+
+            if (thisCh) {
+                callee->setParamType(paramIdx, meet->clone());
+                calleeChanged = true;
+            }
+        }
+
+        if (calleeChanged) {
+            if (m_prog->getProject()->getSettings()->debugTA) {
+                LOG_VERBOSE("Parameter types of '%1' changed by call in '%2'", callee->getName(),
+                            proc->getName());
+            }
+
+            m_workSet.insert(callee);
+        }
+    }
+}
+
+
+void GlobalTypeAnalyzer::scheduleCallers(UserProc *proc)
+{
+    for (const std::shared_ptr<CallStatement> &caller : proc->getCallers()) {
+        UserProc *callerProc = caller->getProc();
+
+        if (callerProc && callerProc->isDecoded()) {
+            m_workSet.insert(callerProc);
+        }
+    }
+}
+
+
+GlobalTypeAnalyzer::InterfaceTypes GlobalTypeAnalyzer::getReturnTypes(UserProc *proc) const
+{
+    InterfaceTypes types;
+
+    if (proc->getRetStmt()) {
+        for (SharedConstStmt ret : proc->getRetStmt()->getReturns()) {
+            if (ret->isAssignment()) {
+                std::shared_ptr<const Assignment> retDef = ret->as<const Assignment>();
+                types.emplace_back(retDef->getLeft()->clone(), retDef->getType()->clone());
+            }
+        }
+    }
+
+    return types;
+}
+
+
+GlobalTypeAnalyzer::InterfaceTypes GlobalTypeAnalyzer::getInterfaceTypes(UserProc *proc) const
+{
+    InterfaceTypes types;
+
+    for (const std::shared_ptr<Parameter> &param : proc->getSignature()->getParameters()) {
+        types.emplace_back(param->getExp()->clone(), param->getType()->clone());
+    }
+
+    const InterfaceTypes returnTypes = getReturnTypes(proc);
+    types.insert(types.end(), returnTypes.begin(), returnTypes.end());
+
+    for (const std::shared_ptr<CallStatement> &call : getUserCalls(proc)) {
+        types.emplace_back(Const::get(call->getDestProc()), nullptr);
+
+        for (SharedConstStmt arg : call->getArguments()) {
+            if (arg->isAssign()) {
+                std::shared_ptr<const Assign> argDef = arg->as<const Assign>();
+                types.emplace_back(argDef->getLeft()->clone(), argDef->getType()->clone());
+            }
+        }
+
+        for (SharedConstStmt def : call->getDefines()) {
+            if (def->isAssignment()) {
+                std::shared_ptr<const Assignment> callDef = def->as<const Assignment>();
+                types.emplace_back(callDef->getLeft()->clone(), callDef->getType()->clone());
+            }
+        }
+    }
+
+    return types;
+}
+
+
+bool GlobalTypeAnalyzer::isSameInterface(const InterfaceTypes &types1,
+                                         const InterfaceTypes &types2)
+{
+    return std::equal(types1.begin(), types1.end(), types2.begin(), types2.end(),
+                      [](const auto &entry1, const auto &entry2) {
+                          if (*entry1.first != *entry2.first) {
+                              return false;
+                          }
+                          else if (!entry1.second || !entry2.second) {
+                              return entry1.second == entry2.second;
+                          }
+
+                          return *entry1.second == *entry2.second;
+                      });
+}
+
+
+std::list<std::shared_ptr<CallStatement>> GlobalTypeAnalyzer::getUserCalls(UserProc *proc) const
+{
+    std::list<std::shared_ptr<CallStatement>> calls;
+
+    for (IRFragment *frag : *proc->getCFG()) {
+        const SharedStmt last = frag->getLastStmt();
+
+        if (!last || !last->isCall()) {
+            continue;
+        }
+
+        std::shared_ptr<CallStatement> call = last->as<CallStatement>();
+        Function *callee                    = call->getDestProc();
+
+        if (callee && !callee->isLib() && static_cast<UserProc *>(callee)->isDecoded()) {
+            calls.push_back(call);
+        }
+    }
+
+    return calls;
+}
@@ -0,0 +1,101 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/proc/UserProc.h"
+
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+class CallStatement;
+class Prog;
+
+
+/**
+ * Interprocedural type analysis.
+ * Local type analysis is run for a procedure, and the types of the arguments of all its calls
+ * are met with the parameter types of the callees. Before a procedure is analyzed,
+ * the types of the results of its calls are met with the return types of the callees.
+ *
+ * The analysis is driven by a worklist over the call graph: A procedure is re-analyzed only if
+ * a caller changed the types of its parameters, or a callee changed its return types.
+ */
+class GlobalTypeAnalyzer
+{
+public:
+    explicit GlobalTypeAnalyzer(Prog *prog);
+
+public:
+    /**
+     * Analyze the types of all decoded procedures until the types of parameters, arguments,
+     * returns and results do not change anymore.
+     * On subsequent calls, only procedures whose interface changed since the last call
+     * (and their callers and callees) are re-analyzed.
+     */
+    void analyzeTypes();
+
+    /// \returns how often \p proc was analyzed by the last call to \ref analyzeTypes.
+    int getNumAnalyzed(UserProc *proc) const;
+
+private:
+    /**
+     * Locations of the interface of a procedure together with copies of their types.
+     * The destination of a call has no type.
+     */
+    typedef std::vector<std::pair<SharedConstExp, SharedConstType>> InterfaceTypes;
+
+    /// Analyze a single procedure and schedule all procedures affected by a type change.
+    void analyzeProc(UserProc *proc);
+
+    /**
+     * Meet the types of the results of all calls in \p proc
+     * with the return types of the callees.
+     * \returns true if any change
+     */
+    bool meetResultTypes(UserProc *proc);
+
+    /**
+     * Meet the types of the arguments of all calls in \p proc
+     * with the parameter types of the callees, and schedule all callees whose
+     * parameter types changed for re-analysis.
+     */
+    void meetArgumentTypes(UserProc *proc);
+
+    /// Schedule all decoded procedures calling \p proc for analysis.
+    void scheduleCallers(UserProc *proc);
+
+    /// \returns the types of all returns of \p proc.
+    InterfaceTypes getReturnTypes(UserProc *proc) const;
+
+    /// \returns the types of the parameters, returns, arguments and results of \p proc.
+    InterfaceTypes getInterfaceTypes(UserProc *proc) const;
+
+    /// \returns true if \p types1 and \p types2 have the same locations and types.
+    static bool isSameInterface(const InterfaceTypes &types1, const InterfaceTypes &types2);
+
+    /// \returns all calls in \p proc to decoded user procedures
+    std::list<std::shared_ptr<CallStatement>> getUserCalls(UserProc *proc) const;
+
+private:
+    Prog *m_prog;
+
+    ProcSet m_workSet; ///< UserProcs that need to be (re-)analyzed
+
+    /// Interface types (\ref getInterfaceTypes) of each procedure after the last analysis.
+    /// Note: Keyed on the pointer value, since procedures might have been removed since then.
+    std::map<UserProc *, InterfaceTypes> m_analyzedTypes;
+
+    /// Number of times each procedure was analyzed during the current run.
+    std::map<UserProc *, int> m_numAnalyzed;
+};
@@ -241,6 +241,27 @@ bool IndirectJumpAnalyzer::decodeIndirectJmp(IRFragment *frag, UserProc *proc)
 }
 
 
+bool IndirectJumpAnalyzer::decodePendingTargets(UserProc *proc)
+{
+    if (m_pendingTargets.empty()) {
+        return false;
+    }
+
+    const std::vector<Address> targets(m_pendingTargets.begin(), m_pendingTargets.end());
+    m_pendingTargets.clear();
+
+    LOG_VERBOSE("Decoding %1 new switch destinations of '%2'", targets.size(), proc->getName());
+    proc->getProg()->getProject()->getProfiler()->addToCounter("batchedSwitchDests",
+                                                               targets.size());
+
+    if (!proc->getProg()->getFrontEnd()->disassembleTargets(proc, targets)) {
+        LOG_WARN("Could not decode all new switch destinations of '%1'", proc->getName());
+    }
+
+    return true;
+}
+
+
 int IndirectJumpAnalyzer::findNumCases(const IRFragment *frag)
 {
     // should actually search from the statement to i
@@ -854,7 +875,8 @@ bool IndirectJumpAnalyzer::createCompJumpDest(BasicBlock *sourceBB, int destIdx,
     BasicBlock *destBB = prog->getCFG()->getBBStartingAt(destAddr);
 
     addCFGEdge(sourceBB, destIdx, destBB);
-    return prog->getFrontEnd()->disassembleProc(sourceBB->getProc(), destAddr);
+    m_pendingTargets.insert(destAddr);
+    return true;
 }
 
 
@@ -13,6 +13,8 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/util/Address.h"
 
+#include <set>
+
 
 class IRFragment;
 class UserProc;
@@ -22,6 +24,10 @@ class BasicBlock;
 /**
  * Analyzes indirect jumps and calls.
  * This includes virtual calls and switch statements.
+ *
+ * New destinations of switch statements are not decoded immediately. Instead, they are collected
+ * while analyzing all computed jumps of a procedure, and decoded together
+ * by \ref decodePendingTargets.
  */
 class BOOMERANG_API IndirectJumpAnalyzer
 {
@@ -30,9 +36,18 @@ public:
      * Analyzes compued jump or compued call fragments.
      * Iff the function needs to be re-decompiled because of a significant change
      * (e.g. new switch arms discovered), this function returns true.
+     * New switch destinations are decoded by the next call to \ref decodePendingTargets.
      */
     bool decodeIndirectJmp(IRFragment *frag, UserProc *proc);
 
+    /**
+     * Decode all switch destinations of \p proc found since the last call in a single
+     * disassembly pass.
+     * \returns true if any destinations were pending, i.e. new code was decoded.
+     * A warning is logged if some of the new code could not be decoded.
+     */
+    bool decodePendingTargets(UserProc *proc);
+
     /**
      * Called when a switch has been identified. Visits the destinations of the switch,
      * adds out edges to the fragment, etc.
@@ -58,9 +73,12 @@ private:
     bool analyzeCompCall(IRFragment *frag, UserProc *proc);
 
     /// Create the destination of an analyzed switch jump, make sure the edge exists
-    /// in the low level CFG, and decode the destination.
-    /// \returns true if a new BasicBlock was decoded
+    /// in the low level CFG, and schedule the destination for decoding.
+    /// \returns true if the destination needs to be decoded or a new edge was added
     bool createCompJumpDest(BasicBlock *sourceBB, int destIdx, Address destAddr);
 
     bool addCFGEdge(BasicBlock *sourceBB, int destIdx, BasicBlock *destBB);
+
+private:
+    std::set<Address> m_pendingTargets; ///< Switch destinations that still need to be decoded
 };
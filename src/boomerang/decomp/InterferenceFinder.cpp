@@ -17,6 +17,10 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/util/log/Log.h"
 
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
 
 InterferenceFinder::InterferenceFinder(ProcCFG *cfg)
     : m_cfg(cfg)
@@ -24,23 +28,28 @@ InterferenceFinder::InterferenceFinder(ProcCFG *cfg)
 }
 
 
-void InterferenceFinder::findInterferences(ConnectionGraph &ig)
+void InterferenceFinder::findInterferences(InterferenceGraph &ig)
 {
     if (m_cfg->getNumFragments() == 0) {
         return;
     }
 
-    std::list<IRFragment *> workList; // List of fragments still to be processed
-    std::set<IRFragment *> workSet;   // Set of the same; used for quick membership test
-    appendFrags(workList, workSet);
+    // Map fragments to dense indices for quick membership tests of the worklist
+    std::unordered_map<IRFragment *, std::size_t> fragIndices;
+    for (IRFragment *frag : *m_cfg) {
+        fragIndices.insert({ frag, fragIndices.size() });
+    }
+
+    std::deque<IRFragment *> workList(m_cfg->begin(), m_cfg->end()); // fragments to process
+    std::vector<bool> inWorkList(fragIndices.size(), true);
 
     int count            = 0;
     const bool debugLive = m_cfg->getProc()->getProg()->getProject()->getSettings()->debugLiveness;
 
     while (!workList.empty() && count++ < 1E5) {
         IRFragment *currFrag = workList.back();
-        workList.erase(--workList.end());
-        workSet.erase(currFrag);
+        workList.pop_back();
+        inWorkList[fragIndices[currFrag]] = false;
 
         // Calculate live locations and interferences
         assert(currFrag->getProc() != nullptr);
@@ -57,28 +66,14 @@ void InterferenceFinder::findInterferences(ConnectionGraph &ig)
                     last ? QString::number(last->getNumber(), 10) : "<none>");
         }
 
-        updateWorkListRev(currFrag, workList, workSet);
-    }
-}
-
+        // Insert inedges of currFrag into the worklist, unless already there
+        for (IRFragment *pred : currFrag->getPredecessors()) {
+            auto it = fragIndices.find(pred);
 
-void InterferenceFinder::updateWorkListRev(IRFragment *currFrag, std::list<IRFragment *> &workList,
-                                           std::set<IRFragment *> &workSet)
-{
-    // Insert inedges of currFrag into the worklist, unless already there
-    for (IRFragment *pred : currFrag->getPredecessors()) {
-        if (workSet.find(pred) == workSet.end()) {
-            workList.push_front(pred);
-            workSet.insert(pred);
+            if (it != fragIndices.end() && !inWorkList[it->second]) {
+                workList.push_front(pred);
+                inWorkList[it->second] = true;
+            }
         }
     }
 }
-
-
-void InterferenceFinder::appendFrags(std::list<IRFragment *> &workList,
-                                     std::set<IRFragment *> &workSet)
-{
-    workList.insert(workList.end(), m_cfg->begin(), m_cfg->end());
-
-    std::copy(m_cfg->begin(), m_cfg->end(), std::inserter(workSet, workSet.end()));
-}
@@ -12,13 +12,10 @@
 
 #include "boomerang/decomp/LivenessAnalyzer.h"
 
-#include <list>
-#include <set>
-
 
 class IRFragment;
 class ProcCFG;
-class ConnectionGraph;
+class InterferenceGraph;
 
 
 /// Finds the interferences generated by more than one version
@@ -29,13 +26,7 @@ public:
     InterferenceFinder(ProcCFG *cfg);
 
 public:
-    void findInterferences(ConnectionGraph &interferences);
-
-private:
-    void appendFrags(std::list<IRFragment *> &workList, std::set<IRFragment *> &workSet);
-
-    void updateWorkListRev(IRFragment *currBB, std::list<IRFragment *> &workList,
-                           std::set<IRFragment *> &workSet);
+    void findInterferences(InterferenceGraph &interferences);
 
 private:
     ProcCFG *m_cfg;
@@ -17,7 +17,7 @@
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/statements/PhiAssign.h"
-#include "boomerang/util/ConnectionGraph.h"
+#include "boomerang/util/InterferenceGraph.h"
 #include "boomerang/util/log/Log.h"
 
 #include <deque>
@@ -29,7 +29,8 @@
  * Also check for type conflicts when using DFA type analysis
  * This is a helper function.
  */
-void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig, UserProc *proc)
+void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, InterferenceGraph &ig,
+                     UserProc *proc)
 {
     // For each location to be considered
     for (SharedExp exp : ls) {
@@ -61,7 +62,7 @@ void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig
 }
 
 
-bool LivenessAnalyzer::calcLiveness(IRFragment *frag, ConnectionGraph &ig, UserProc *myProc)
+bool LivenessAnalyzer::calcLiveness(IRFragment *frag, InterferenceGraph &ig, UserProc *myProc)
 {
     // Start with the liveness at the bottom of the fragment
     LocationSet liveLocs, phiLocs;
@@ -77,7 +78,7 @@ bool LivenessAnalyzer::calcLiveness(IRFragment *frag, ConnectionGraph &ig, UserP
     if (frag->getRTLs()) {
         // For all statements in this fragment in reverse order
         IRFragment::RTLRIterator rit;
-        StatementList::reverse_iterator sit;
+        RTL::reverse_iterator sit;
 
         for (SharedStmt s = frag->getLastStmt(rit, sit); s; s = frag->getPrevStmt(rit, sit)) {
             LocationSet defs;
@@ -16,7 +16,7 @@
 
 
 class IRFragment;
-class ConnectionGraph;
+class InterferenceGraph;
 class UserProc;
 
 
@@ -26,7 +26,7 @@ public:
     LivenessAnalyzer() = default;
 
     // Liveness
-    bool calcLiveness(IRFragment *frag, ConnectionGraph &ig, UserProc *proc);
+    bool calcLiveness(IRFragment *frag, InterferenceGraph &ig, UserProc *proc);
 
     /// Locations that are live at the end of this BB are the union of the locations that are live
     /// at the start of its successors. \p live gets all the livenesses,
@@ -20,11 +20,16 @@
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Ternary.h"
 #include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/CaseStatement.h"
 #include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/util/log/SeparateLogger.h"
 
 
+/// Maximum number of times a procedure is lifted again after resolving switch statements early
+static constexpr const int MAX_EARLY_SWITCH_ROUNDS = 10;
+
+
 ProcDecompiler::ProcDecompiler()
 {
 }
@@ -78,6 +83,7 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
     proc->numberStatements();
 
     earlyDecompile(proc);
+    resolveSwitchesEarly(proc);
 
     if (project->getSettings()->decodeChildren) {
         // Recurse to callees first, to perform a depth first search
@@ -249,6 +255,8 @@ void ProcDecompiler::addToRecursionGroup(UserProc *proc,
 void ProcDecompiler::earlyDecompile(UserProc *proc)
 {
     Project *project = proc->getProg()->getProject();
+    ProfileScope scope(project->getProfiler(), ProfileCategory::Proc, "earlyDecompile", proc);
+
     project->alertStartDecompile(proc);
     project->alertDecompileDebugPoint(proc, "before earlyDecompile");
 
@@ -277,10 +285,71 @@ void ProcDecompiler::earlyDecompile(UserProc *proc)
 }
 
 
+void ProcDecompiler::resolveSwitchesEarly(UserProc *proc)
+{
+    Project *project = proc->getProg()->getProject();
+
+    // Decoding the new code resets the status to Decoded, but the proc is still being visited.
+    // Keep the status, otherwise recursive calls to the proc would not be detected.
+    const ProcStatus status = proc->getStatus();
+
+    // Each round can only find switches in code found by the previous round,
+    // so the number of rounds is bounded by the nesting depth of switch statements.
+    for (int round = 0; round < MAX_EARLY_SWITCH_ROUNDS && !checkBudget(proc); ++round) {
+        bool changed = false;
+        IndirectJumpAnalyzer analyzer;
+
+        for (IRFragment *frag : *proc->getCFG()) {
+            if (!frag->isType(FragType::CompJump)) {
+                continue;
+            }
+
+            std::shared_ptr<CaseStatement> caseStmt = frag->getLastStmt()->as<CaseStatement>();
+            if (!caseStmt->getDest()) {
+                continue;
+            }
+
+            const SharedExp oldDest = caseStmt->getDest()->clone();
+
+            if (analyzer.decodeIndirectJmp(frag, proc)) {
+                changed = true;
+            }
+            else if (frag->isType(FragType::CompJump)) {
+                // Not resolved; undo the forced propagation so middleDecompile can try again
+                // with the same input as without early resolution.
+                caseStmt->setDest(oldDest);
+            }
+        }
+
+        changed |= analyzer.decodePendingTargets(proc);
+        proc->setStatus(status);
+
+        if (!changed) {
+            return;
+        }
+
+        // New code was decoded. Only early decompilation depends on the IR so far,
+        // so lift the procedure again instead of restarting its decompilation later.
+        LOG_VERBOSE("Lifting '%1' again after resolving switch statements", proc->getName());
+        project->getProfiler()->addToCounter("avoidedRestarts");
+
+        proc->removeRetStmt();
+        proc->getCFG()->clear();
+
+        PassManager::get()->executePass(PassID::StatementInit, proc);
+        project->alertDecompileDebugPoint(proc, "after lifting");
+
+        proc->numberStatements();
+        earlyDecompile(proc);
+    }
+}
+
+
 void ProcDecompiler::middleDecompile(UserProc *proc)
 {
     assert(m_callStack.back() == proc);
     Project *project = proc->getProg()->getProject();
+    ProfileScope scope(project->getProfiler(), ProfileCategory::Proc, "middleDecompile", proc);
 
     project->alertDecompileDebugPoint(proc, "before middleDecompile");
 
@@ -331,7 +400,10 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     // Otherwise sometimes sp is not fully propagated
     PassManager::get()->executePass(PassID::StatementPropagation, proc);
     PassManager::get()->executePass(PassID::CallArgumentUpdate, proc);
-    PassManager::get()->executePass(PassID::StrengthReductionReversal, proc);
+
+    if (!checkBudget(proc)) {
+        PassManager::get()->executePass(PassID::StrengthReductionReversal, proc);
+    }
 
     project->alertDecompileDebugPoint(proc, "after updating call arguments");
 
@@ -381,7 +453,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         PassManager::get()->executePass(PassID::AssignRemoval, proc);
         project->alertDecompileDebugPoint(proc,
                                           "after updating returns pass " + QString::number(pass));
-    } while (change && ++pass < 12);
+    } while (change && ++pass < 12 && !checkBudget(proc));
 
     // At this point, there will be some memofs that have still not been renamed. They have been
     // prevented from getting renamed so that they didn't get renamed incorrectly (usually as {-}),
@@ -403,22 +475,33 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     project->alertDecompileDebugPoint(proc, "after renaming memofs");
 
     // Check for indirect jumps or calls not already removed by propagation of constants
-    bool changed = false;
+    const ProcStatus status = proc->getStatus();
+    bool changed            = false;
     IndirectJumpAnalyzer analyzer;
 
     for (IRFragment *frag : *proc->getCFG()) {
         changed |= analyzer.decodeIndirectJmp(frag, proc);
     }
 
+    // Decode the new destinations of all switch statements at once
+    changed |= analyzer.decodePendingTargets(proc);
+
     project->alertDecompileDebugPoint(proc, "after analyzing indirect jumps");
 
-    if (changed) {
+    if (changed && !checkBudget(proc)) {
         // There was at least one indirect jump or call found and decoded. That means that most of
         // what has been done to this function so far is invalid. So redo everything. Very
         // expensive!!
         reDecompileRecursive(proc);
         return;
     }
+    else if (changed) {
+        // Restarting could exceed the budget again and again. Keep the current CFG instead;
+        // the new code is not part of the output. Decoding it reset the status, so restore it.
+        LOG_WARN("Not restarting decompilation of '%1' for new code, since it is over budget",
+                 proc->getName());
+        proc->setStatus(status);
+    }
 
     PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
     PassManager::get()->executePass(PassID::DuplicateArgsRemoval, proc);
@@ -427,7 +510,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     // processing, do the local TA pass now. Ellipsis processing often reveals additional uses (e.g.
     // additional parameters to printf/scanf), and removing unused statements is unsafe without full
     // use information
-    if (!proc->isDecompiled()) {
+    if (!proc->isDecompiled() && !checkBudget(proc)) {
         PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
 
         // Now that locals are identified, redo the dataflow
@@ -530,7 +613,7 @@ void ProcDecompiler::recursionGroupAnalysis(const std::shared_ptr<ProcSet> &grou
     do {
         ProcSet visited;
         changed = decompileProcInRecursionGroup(entry, visited);
-    } while (changed && numRepeats++ < 2);
+    } while (changed && numRepeats++ < 2 && !checkBudget(entry));
 
     // while no change
     for (int i = 0; i < 2; i++) {
@@ -549,6 +632,8 @@ void ProcDecompiler::recursionGroupAnalysis(const std::shared_ptr<ProcSet> &grou
 void ProcDecompiler::lateDecompile(UserProc *proc)
 {
     Project *project = proc->getProg()->getProject();
+    ProfileScope scope(project->getProfiler(), ProfileCategory::Proc, "lateDecompile", proc);
+
     project->alertDecompiling(proc);
     project->alertDecompileDebugPoint(proc, "before lateDecompile");
 
@@ -577,11 +662,38 @@ void ProcDecompiler::printCallStack()
 }
 
 
+bool ProcDecompiler::checkBudget(UserProc *proc)
+{
+    if (proc->isDegraded()) {
+        return true;
+    }
+
+    const Settings *settings = proc->getProg()->getProject()->getSettings();
+
+    const bool overTime = settings->procTimeBudget > 0 &&
+                          proc->getPassTime() > std::chrono::seconds(settings->procTimeBudget);
+    const bool overPasses = settings->procPassBudget > 0 &&
+                            proc->getNumExecutedPasses() > settings->procPassBudget;
+
+    if (!overTime && !overPasses) {
+        return false;
+    }
+
+    LOG_WARN("Decompilation of '%1' exceeded its %2 budget, continuing with a reduced pipeline",
+             proc->getName(), overTime ? "time" : "pass");
+
+    proc->setDegraded(true);
+    proc->getProg()->getProject()->getProfiler()->addToCounter("degradedProcs");
+    return true;
+}
+
+
 ProcStatus ProcDecompiler::reDecompileRecursive(UserProc *proc)
 {
     Project *project = proc->getProg()->getProject();
 
     LOG_MSG("Restarting decompilation of '%1'", proc->getName());
+    project->getProfiler()->addToCounter("restartedProcs");
     project->alertDecompileDebugPoint(proc, "before restarting decompilation");
 
     // decode from scratch
@@ -625,11 +737,10 @@ bool ProcDecompiler::tryConvertCallsToDirect(UserProc *proc)
 
 bool ProcDecompiler::tryConvertFunctionPointerAssignments(UserProc *proc)
 {
-    bool changed = false;
-    StatementList statements;
-    proc->getStatements(statements);
+    bool changed          = false;
+    const auto statements = proc->getStatementIndex();
 
-    for (SharedStmt stmt : statements) {
+    for (const SharedStmt &stmt : *statements) {
         if (stmt->isAssign()) {
             std::shared_ptr<Assign> asgn = stmt->as<Assign>();
             if (asgn->getType()->resolvesToFuncPtr()) {
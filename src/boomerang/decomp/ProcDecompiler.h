@@ -43,6 +43,14 @@ private:
     /// rename, propagation: ready for preserveds.
     void earlyDecompile(UserProc *proc);
 
+    /**
+     * Try to resolve all switch statements of \p proc right after early decompilation.
+     * Whenever new code is found, \p proc is lifted and early decompiled again. This is much
+     * cheaper than restarting the decompilation in \ref middleDecompile, since neither callees
+     * nor middle decompilation have been processed yet.
+     */
+    void resolveSwitchesEarly(UserProc *proc);
+
     /// Middle decompile: All the decompilation from preservation up to
     /// but not including removing unused statements.
     /// \returns the cycle set from the recursive call to decompile()
@@ -60,6 +68,14 @@ private:
 
     void printCallStack();
 
+    /**
+     * Check whether \p proc has used up its time or pass budget (see \ref Settings).
+     * If so, \p proc is marked as degraded, and the rest of its decompilation skips
+     * optional passes and iterations.
+     * \returns true if \p proc is degraded.
+     */
+    bool checkBudget(UserProc *proc);
+
     /**
      * Re-decompile \p proc from scratch. The proc must be at the top of the call stack
      * (i.e. the one that is currently decompiled).
@@ -20,11 +20,13 @@
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/CallStatement.h"
 #include "boomerang/util/log/Log.h"
 
 
 ProgDecompiler::ProgDecompiler(Prog *prog)
     : m_prog(prog)
+    , m_typeAnalyzer(prog)
 {
 }
 
@@ -70,18 +72,13 @@ void ProgDecompiler::decompile()
     globalTypeAnalysis();
 
     if (m_prog->getProject()->getSettings()->removeReturns) {
-        // Repeat until no change. Not 100% sure if needed.
-        while (removeUnusedParamsAndReturns()) {
-            for (auto &module : m_prog->getModuleList()) {
-                for (Function *proc : *module) {
-                    if (proc->isLib()) {
-                        continue;
-                    }
-
-                    PassManager::get()->executePass(PassID::BranchAnalysis,
-                                                    static_cast<UserProc *>(proc));
-                }
-            }
+        if (m_finishedProcs.empty()) {
+            removeUnusedParamsAndReturns();
+        }
+        else {
+            // Procedures decompiled on demand are not in SSA form anymore
+            LOG_WARN("Not removing unused returns because some procedures were already "
+                     "decompiled on demand");
         }
     }
 
@@ -92,6 +89,7 @@ void ProgDecompiler::decompile()
     removeUnusedGlobals();
 
     LOG_MSG("Compressing CFG...");
+    ProfileScope scope(m_prog->getProject()->getProfiler(), ProfileCategory::Phase, "compressCFG");
 
     for (const auto &module : m_prog->getModuleList()) {
         for (Function *func : *module) {
@@ -105,28 +103,39 @@ void ProgDecompiler::decompile()
 }
 
 
+bool ProgDecompiler::decompileOnDemand(UserProc *proc)
+{
+    if (m_finishedProcs.find(proc) != m_finishedProcs.end()) {
+        LOG_VERBOSE("Procedure '%1' is already decompiled", proc->getName());
+        return true;
+    }
+
+    if (!proc->isDecompiled()) {
+        LOG_MSG("Decompiling '%1' on demand...", proc->getName());
+        proc->decompileRecursive();
+
+        if (!proc->isDecompiled()) {
+            LOG_WARN("Could not decompile '%1'", proc->getName());
+            return false;
+        }
+    }
+
+    finishProc(proc);
+    return true;
+}
+
+
 void ProgDecompiler::globalTypeAnalysis()
 {
+    ProfileScope scope(m_prog->getProject()->getProfiler(), ProfileCategory::Phase,
+                       "globalTypeAnalysis");
     LOG_MSG("Performing global type analysis...");
 
     if (m_prog->getProject()->getSettings()->debugTA) {
         LOG_VERBOSE("### Start global data-flow-based type analysis ###");
     }
 
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *pp : *module) {
-            UserProc *proc = dynamic_cast<UserProc *>(pp);
-
-            if (!proc || !proc->isDecoded()) {
-                continue;
-            }
-
-            // FIXME: this just does local TA again. Need to meet types for all parameter/arguments,
-            // and return/results! This will require a repeat until no change loop
-            LOG_VERBOSE("Global type analysis for '%1'", proc->getName());
-            PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
-        }
-    }
+    m_typeAnalyzer.analyzeTypes();
 
     if (m_prog->getProject()->getSettings()->debugTA) {
         LOG_VERBOSE("### End type analysis ###");
@@ -136,6 +145,8 @@ void ProgDecompiler::globalTypeAnalysis()
 
 void ProgDecompiler::removeUnusedGlobals()
 {
+    ProfileScope scope(m_prog->getProject()->getProfiler(), ProfileCategory::Phase,
+                       "removeUnusedGlobals");
     LOG_MSG("Removing unused global variables...");
 
     // seach for used globals
@@ -151,11 +162,7 @@ void ProgDecompiler::removeUnusedGlobals()
             Location search(opGlobal, Terminal::get(opWild), proc);
             // Search each statement in u, excepting implicit assignments (their uses don't count,
             // since they don't really exist in the program representation)
-            StatementList stmts;
-            StatementList::iterator ss;
-            proc->getStatements(stmts);
-
-            for (SharedStmt s : stmts) {
+            for (const SharedStmt &s : proc->getStatementRange()) {
                 if (s->isImplicit()) {
                     continue; // Ignore the uses in ImplicitAssigns
                 }
@@ -198,15 +205,58 @@ void ProgDecompiler::removeUnusedGlobals()
 }
 
 
-bool ProgDecompiler::removeUnusedParamsAndReturns()
+void ProgDecompiler::removeUnusedParamsAndReturns()
 {
+    ProfileScope scope(m_prog->getProject()->getProfiler(), ProfileCategory::Phase,
+                       "removeUnusedReturns");
     LOG_MSG("Removing unused returns...");
-    return UnusedReturnRemover(m_prog).removeUnusedReturns();
+
+    UnusedReturnRemover remover(m_prog);
+    bool change   = remover.removeUnusedReturns();
+    int numRounds = 1;
+
+    // Repeat until no change. Branch analysis of the changed procedures might remove fragments
+    // and therefore uses; only these procedures and their neighbours in the call graph
+    // need to be analyzed again.
+    while (change) {
+        ProcSet workSet;
+
+        for (UserProc *proc : remover.getChangedProcs()) {
+            if (!PassManager::get()->executePass(PassID::BranchAnalysis, proc)) {
+                continue;
+            }
+
+            workSet.insert(proc);
+
+            for (const std::shared_ptr<CallStatement> &caller : proc->getCallers()) {
+                if (caller->getProc()) {
+                    workSet.insert(caller->getProc());
+                }
+            }
+
+            for (Function *callee : proc->getCallees()) {
+                if (!callee->isLib() && static_cast<UserProc *>(callee)->isDecoded()) {
+                    workSet.insert(static_cast<UserProc *>(callee));
+                }
+            }
+        }
+
+        if (workSet.empty()) {
+            break;
+        }
+
+        LOG_VERBOSE("Removing unused returns: Re-analyzing %1 procedures", workSet.size());
+        change = remover.removeUnusedReturns(workSet);
+        numRounds++;
+    }
+
+    LOG_VERBOSE("Removed unused returns in %1 rounds", numRounds);
 }
 
 
 void ProgDecompiler::fromSSAForm()
 {
+    ProfileScope scope(m_prog->getProject()->getProfiler(), ProfileCategory::Phase, "fromSSAForm");
     LOG_MSG("Transforming from SSA form...");
 
     for (const auto &module : m_prog->getModuleList()) {
@@ -216,8 +266,25 @@ void ProgDecompiler::fromSSAForm()
             }
 
             UserProc *proc = static_cast<UserProc *>(pp);
+            if (m_finishedProcs.find(proc) != m_finishedProcs.end()) {
+                continue;
+            }
+
             proc->numberStatements();
             PassManager::get()->executePass(PassID::FromSSAForm, proc);
+            m_finishedProcs.insert(proc);
         }
     }
 }
+
+
+void ProgDecompiler::finishProc(UserProc *proc)
+{
+    if (!m_finishedProcs.insert(proc).second) {
+        return;
+    }
+
+    proc->numberStatements();
+    PassManager::get()->executePass(PassID::FromSSAForm, proc);
+    CFGCompressor().compressCFG(proc->getCFG());
+}
@@ -11,6 +11,8 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/GlobalTypeAnalyzer.h"
 
 
 class Prog;
@@ -25,22 +27,42 @@ public:
     /// Do the main non-global decompilation steps
     void decompile();
 
+    /**
+     * Decompile \p proc and all procedures it calls, but nothing else, and transform \p proc
+     * out of SSA form so code can be generated for it. Procedures that were already
+     * decompiled are not decompiled again.
+     * The callees of \p proc stay in SSA form; they are only finished when they are requested
+     * themselves or when the whole program is decompiled.
+     * The whole-program analyses (global type analysis, removing unused returns and globals)
+     * are skipped, since they need all callers of a procedure.
+     * \returns true on success.
+     */
+    bool decompileOnDemand(UserProc *proc);
+
 private:
-    /// Do global type analysis.
-    /// \note For now, it just does local type analysis for every procedure of the program.
+    /// Do global type analysis. Parameter and argument types as well as return and result types
+    /// are met across all calls until no change. Only procedures affected by changes since the
+    /// last call are re-analyzed.
     void globalTypeAnalysis();
 
     /// As the name suggests, removes globals unused in the decompiled code.
     void removeUnusedGlobals();
 
-    /// Remove unused or redundant parameters and return values from the program.
-    /// \returns true if any change
-    bool removeUnusedParamsAndReturns();
+    /// Remove unused or redundant parameters and return values from the program,
+    /// and run branch analysis on all procedures changed by this until no change.
+    void removeUnusedParamsAndReturns();
 
     /// Have to transform out of SSA form after the above final pass
     /// Convert from SSA form
     void fromSSAForm();
 
+    /// Transform \p proc out of SSA form and compress its CFG, unless this was done before.
+    void finishProc(UserProc *proc);
+
 private:
     Prog *m_prog;
+    GlobalTypeAnalyzer m_typeAnalyzer;
+
+    /// Procedures that have been transformed out of SSA form
+    ProcSet m_finishedProcs;
 };
@@ -42,15 +42,26 @@ UnusedReturnRemover::UnusedReturnRemover(Prog *prog)
 
 bool UnusedReturnRemover::removeUnusedReturns()
 {
+    ProcSet procs;
+
     for (const auto &module : m_prog->getModuleList()) {
         for (Function *proc : *module) {
             if (proc && !proc->isLib() && static_cast<UserProc *>(proc)->isDecoded()) {
-                m_removeRetSet.insert(static_cast<UserProc *>(proc));
+                procs.insert(static_cast<UserProc *>(proc));
             }
             // else e.g. use -sf file to just prototype the proc
         }
     }
 
+    return removeUnusedReturns(procs);
+}
+
+
+bool UnusedReturnRemover::removeUnusedReturns(const ProcSet &procs)
+{
+    m_removeRetSet = procs;
+    m_changedProcs.clear();
+
     bool change = false;
     // The workset is processed in order of entry address. This is to provide a consistent
     // deterministic order of processing. Note that sometimes changes propagate down the call tree
@@ -68,6 +79,7 @@ bool UnusedReturnRemover::removeUnusedReturns()
 
             // type analysis might propagate statements that could not be propagated before
             PassManager::get()->executePass(PassID::UnusedStatementRemoval, *it);
+            m_changedProcs.insert(*it);
         }
         change |= removedReturns;
 
@@ -204,6 +216,8 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
         LOG_MSG("%%% updating dataflow:");
     }
 
+    m_changedProcs.insert(proc);
+
     // Save the old parameters and call liveness
     const size_t oldNumParameters = proc->getParameters().size();
     std::map<std::shared_ptr<CallStatement>, UseCollector> callLiveness;
@@ -40,6 +40,19 @@ public:
      */
     bool removeUnusedReturns();
 
+    /**
+     * Remove unused return locations, starting with the procedures in \p procs.
+     * Other procedures are only analyzed when they are affected by changes
+     * to the procedures in \p procs.
+     * \returns true if any change
+     * \sa removeUnusedReturns()
+     */
+    bool removeUnusedReturns(const ProcSet &procs);
+
+    /// \returns all procedures whose returns, parameters or data flow were changed
+    /// during the last call to \ref removeUnusedReturns.
+    const ProcSet &getChangedProcs() const { return m_changedProcs; }
+
 private:
     /**
      * Remove any returns that are not used by any callers
@@ -87,4 +100,5 @@ private:
 private:
     Prog *m_prog;
     ProcSet m_removeRetSet; ///< UserProcs that need their returns updated
+    ProcSet m_changedProcs; ///< UserProcs changed during the last run
 };
@@ -14,6 +14,8 @@
 #include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/LowLevelCFG.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
 #include "boomerang/db/binary/BinarySection.h"
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
@@ -35,6 +37,9 @@
 #include "boomerang/ssl/type/NamedType.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QDir>
+
+#include <algorithm>
 #include <stack>
 #include <stdexcept>
 
@@ -58,6 +63,15 @@ bool DefaultFrontEnd::initialize(Project *project)
     m_program    = project->getProg();
     m_binaryFile = project->getLoadedBinaryFile();
 
+    // The frontend outlives the Prog when several binaries are decompiled in a row,
+    // so forget everything about the previous one.
+    m_refHints.clear();
+    m_firstFragment.clear();
+    m_lastFragment.clear();
+    m_needSuccessors.clear();
+
+    readLibraryPatterns();
+
     if (!m_decoder) {
         return false;
     }
@@ -147,13 +161,16 @@ bool DefaultFrontEnd::disassembleAll()
         change = false;
 
         for (const auto &m : m_program->getModuleList()) {
-            for (Function *function : *m) {
+            // Recognizing a library function removes it from the module,
+            // so advance the iterator before looking at the function.
+            for (auto it = m->begin(); it != m->end();) {
+                Function *function = *it++;
                 if (function->isLib()) {
                     continue;
                 }
 
                 UserProc *userProc = static_cast<UserProc *>(function);
-                if (userProc->isDecoded()) {
+                if (userProc->isDecoded() || recognizeLibraryFunction(userProc)) {
                     continue;
                 }
 
@@ -212,16 +229,35 @@ bool DefaultFrontEnd::disassembleFunctionAtAddr(Address addr)
 
 bool DefaultFrontEnd::disassembleProc(UserProc *proc, Address addr)
 {
-    LOG_VERBOSE("### Disassembing proc '%1' at address %2 ###", proc->getName(), addr);
+    return disassembleTargets(proc, { addr });
+}
+
+
+bool DefaultFrontEnd::disassembleTargets(UserProc *proc, const std::vector<Address> &targets)
+{
+    assert(!targets.empty());
+    m_program->getProject()->checkDeadline();
+
+    if (targets.size() == 1) {
+        LOG_VERBOSE("### Disassembing proc '%1' at address %2 ###", proc->getName(),
+                    targets.front());
+    }
+    else {
+        LOG_VERBOSE("### Disassembing proc '%1' at %2 addresses ###", proc->getName(),
+                    targets.size());
+    }
 
     LowLevelCFG *cfg = proc->getProg()->getCFG();
     assert(cfg);
 
-    m_targetQueue.initial(addr);
+    for (Address target : targets) {
+        m_targetQueue.initial(target);
+    }
 
     int numBytesDecoded = 0;
-    Address startAddr   = addr;
-    Address lastAddr    = addr;
+    Address startAddr   = *std::min_element(targets.begin(), targets.end());
+    Address lastAddr    = startAddr;
+    Address addr        = Address::INVALID;
     MachineInstruction insn;
 
     while ((addr = m_targetQueue.popAddress(*cfg)) != Address::INVALID) {
@@ -476,6 +512,12 @@ bool DefaultFrontEnd::disassembleProc(UserProc *proc, Address addr)
                         break;
                     }
 
+                    // Add the call to the low-level call graph
+                    const Function *callee = call->getDestProc();
+                    if (callee && !callee->isLib()) {
+                        cfg->addCallEdge(proc->getEntryAddress(), callee->getEntryAddress());
+                    }
+
                     // Record the called address as the start of a new procedure if it
                     // didn't already exist.
                     if (!callAddr.isZero() && (callAddr != Address::INVALID) &&
@@ -622,7 +664,7 @@ bool DefaultFrontEnd::liftProcImpl(UserProc *proc)
     procCFG->setEntryAndExitFragment(procCFG->getFragmentByAddr(proc->getEntryAddress()));
 
     IRFragment::RTLIterator rit;
-    StatementList::iterator sit;
+    RTL::iterator sit;
 
     for (IRFragment *frag : *procCFG) {
         for (SharedStmt stmt = frag->getFirstStmt(rit, sit); stmt != nullptr;
@@ -1312,6 +1354,81 @@ Address DefaultFrontEnd::getAddrOfLibraryThunk(const std::shared_ptr<CallStateme
 }
 
 
+void DefaultFrontEnd::readLibraryPatterns()
+{
+    m_libraryPatterns.clear();
+
+    if (!m_program || !m_binaryFile) {
+        return;
+    }
+
+    QString patternFileName;
+    switch (m_binaryFile->getMachine()) {
+    case Machine::X86: patternFileName = "signatures/x86.pat"; break;
+    case Machine::PPC: patternFileName = "signatures/ppc.pat"; break;
+    case Machine::ST20: patternFileName = "signatures/st20.pat"; break;
+    default: return;
+    }
+
+    const QDir dataDir    = m_program->getProject()->getSettings()->getDataDirectory();
+    const int numPatterns = m_libraryPatterns.readPatternFile(
+        dataDir.absoluteFilePath(patternFileName));
+
+    if (numPatterns > 0) {
+        LOG_MSG("Read %1 library function patterns", numPatterns);
+    }
+}
+
+
+bool DefaultFrontEnd::recognizeLibraryFunction(UserProc *proc)
+{
+    if (m_libraryPatterns.isEmpty()) {
+        return false;
+    }
+
+    const Address entryAddr = proc->getEntryAddress();
+    const QString libName   = matchLibraryPattern(entryAddr);
+
+    if (libName.isEmpty()) {
+        return false;
+    }
+    else if (m_program->getFunctionByName(libName) != nullptr) {
+        // Function names must be unique, e.g. if there is an imported function
+        // with the same name or another copy of the same function.
+        LOG_VERBOSE("Not replacing '%1' by library function '%2': Name already exists",
+                    proc->getName(), libName);
+        return false;
+    }
+
+    LOG_VERBOSE("Recognized library function '%1' at address %2", libName, entryAddr);
+
+    // The signature of the library function is looked up by name when it is created.
+    Module *module = proc->getModule();
+    m_program->removeFunction(proc->getName());
+    module->createFunction(libName, entryAddr, true);
+
+    m_program->getProject()->getProfiler()->addToCounter("recognizedLibProcs");
+    return true;
+}
+
+
+QString DefaultFrontEnd::matchLibraryPattern(Address entryAddr) const
+{
+    const BinarySection *section = m_binaryFile->getImage()->getSectionByAddr(entryAddr);
+
+    if (!section || section->getHostAddr() == HostAddress::INVALID ||
+        section->isAddressBss(entryAddr)) {
+        return "";
+    }
+
+    const HostAddress host     = section->getHostAddr() - section->getSourceAddr() + entryAddr;
+    const Address sectionEnd   = section->getSourceAddr() + section->getSize();
+    const std::size_t numBytes = (sectionEnd - entryAddr).value();
+
+    return m_libraryPatterns.match(reinterpret_cast<const Byte *>(host.value()), numBytes);
+}
+
+
 void DefaultFrontEnd::tagFunctionBBs(UserProc *proc)
 {
     std::set<BasicBlock *> visited;
@@ -13,6 +13,7 @@
 #include "boomerang/frontend/TargetQueue.h"
 #include "boomerang/ifc/IFrontEnd.h"
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/util/BytePatternTrie.h"
 
 #include <map>
 
@@ -72,6 +73,10 @@ public:
     /// \copydoc IFrontEnd::disassembleProc
     [[nodiscard]] bool disassembleProc(UserProc *proc, Address addr) override;
 
+    /// \copydoc IFrontEnd::disassembleTargets
+    [[nodiscard]] bool disassembleTargets(UserProc *proc,
+                                          const std::vector<Address> &targets) override;
+
     /// \copydoc IFrontEnd::liftProc
     /// \note Derived classes should implement \ref liftProcImpl
     [[nodiscard]] bool liftProc(UserProc *proc) final override;
@@ -163,6 +168,20 @@ private:
      */
     Address getAddrOfLibraryThunk(const std::shared_ptr<CallStatement> &call, UserProc *proc);
 
+    /// Read the byte patterns of library functions for the machine of the loaded binary.
+    void readLibraryPatterns();
+
+    /**
+     * If the first bytes of \p proc match a library function pattern, replace \p proc
+     * by a library procedure, so it is neither decoded nor decompiled.
+     * \returns true if \p proc was replaced.
+     */
+    bool recognizeLibraryFunction(UserProc *proc);
+
+    /// \returns the name of the library function starting at \p entryAddr, or an empty string
+    /// if the bytes at \p entryAddr do not match any library function pattern.
+    QString matchLibraryPattern(Address entryAddr) const;
+
 protected:
     /// After disassembly, tag all the BBs that are part of \p proc
     void tagFunctionBBs(UserProc *proc);
@@ -182,4 +201,7 @@ protected:
 
     /// Stores the list of fragments needing successors during lifting
     std::list<IRFragment *> m_needSuccessors;
+
+    /// Entry byte patterns of statically linked library functions
+    BytePatternTrie m_libraryPatterns;
 };
@@ -56,6 +56,14 @@ public:
     /// \returns true for a good decode (no illegal instructions)
     [[nodiscard]] virtual bool disassembleProc(UserProc *proc, Address addr) = 0;
 
+    /// Disassemble the parts of a single procedure starting at any of \p targets
+    /// in a single pass, e.g. all newly discovered destinations of switch statements.
+    /// \param proc the procedure object
+    /// \param targets the addresses to start disassembling from (must not be empty)
+    /// \returns true for a good decode (no illegal instructions)
+    [[nodiscard]] virtual bool disassembleTargets(UserProc *proc,
+                                                  const std::vector<Address> &targets) = 0;
+
     /// Lift all instructions for a proc.
     /// \returns true on success, false on failure
     [[nodiscard]] virtual bool liftProc(UserProc *proc) = 0;
@@ -42,11 +42,29 @@
 #include "boomerang/util/log/Log.h"
 
 #include <cassert>
+#include <chrono>
 
 
 static PassManager g_passManager;
 
 
+/// Keeps track of the nesting depth of pass executions, even if a pass throws.
+class NestingScope
+{
+public:
+    explicit NestingScope(int &depth)
+        : m_depth(depth)
+    {
+        m_depth++;
+    }
+
+    ~NestingScope() { m_depth--; }
+
+private:
+    int &m_depth;
+};
+
+
 PassManager::PassManager()
 {
     m_passes.resize(static_cast<size_t>(PassID::NUM_PASSES));
@@ -106,13 +124,42 @@ bool PassManager::executePass(PassID passID, UserProc *proc)
 bool PassManager::executePass(IPass *pass, UserProc *proc)
 {
     assert(pass != nullptr);
+
+    Project *project = proc->getProg() ? proc->getProg()->getProject() : nullptr;
+    if (project) {
+        project->checkDeadline();
+    }
+
     LOG_VERBOSE("Executing pass '%1' for '%2'", pass->getName(), proc->getName());
 
-    const bool change = pass->execute(proc);
+    // The IR might have been changed directly since the index was built.
+    proc->invalidateStatementIndex();
+
+    // Only account for the outermost pass, since its time includes the time of nested passes.
+    const bool isOutermost = m_nestingDepth == 0;
+    const auto start       = std::chrono::steady_clock::now();
+    bool change            = false;
+    {
+        NestingScope nesting(m_nestingDepth);
+        ProfileScope scope(project ? project->getProfiler() : nullptr, ProfileCategory::Pass,
+                           pass->getName(), proc);
+        change = pass->execute(proc);
+    }
+
+    if (change) {
+        // The pass might have changed statements in place, which invalidates previous proofs.
+        proc->invalidateIRCaches();
+    }
+    else {
+        proc->invalidateStatementIndex();
+    }
+
+    if (isOutermost) {
+        proc->addPassCost(std::chrono::steady_clock::now() - start);
+    }
 
-    if (Log::getOrCreateLog().getLogLevel() >= LogLevel::Verbose1) {
-        const QString msg = QString("after executing pass '%1'").arg(pass->getName());
-        proc->debugPrintAll(msg);
+    if (project && project->getIRDumper()->isEnabled()) {
+        project->getIRDumper()->dumpAfterPass(proc, pass->getName());
     }
 
     return change;
@@ -49,4 +49,5 @@ private:
 
 private:
     std::vector<std::unique_ptr<IPass>> m_passes;
+    int m_nestingDepth = 0; ///< Number of passes currently executing
 };
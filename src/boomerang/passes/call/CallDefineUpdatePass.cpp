@@ -29,12 +29,11 @@ CallDefineUpdatePass::CallDefineUpdatePass()
 
 bool CallDefineUpdatePass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     bool changed = false;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (!s->isCall()) {
             continue;
         }
@@ -93,7 +92,7 @@ bool CallDefineUpdatePass::updateCallDefines(UserProc *proc,
     }
     else {
         // Ensure that everything in the UseCollector has an entry in oldDefines
-        for (SharedExp loc : *callStmt->getUseCollector()) {
+        for (SharedExp loc : callStmt->getUseCollector()->getUses()) {
             if (!proc->canBeReturn(loc)) {
                 continue; // Filtered out
             }
@@ -61,6 +61,13 @@ bool BlockVarRenamePass::execute(UserProc *proc)
 #endif
 
     stacks.clear();
+    m_defPool.clear();
+
+    if (changed) {
+        // Previous proofs might refer to old definitions
+        proc->clearProofCache();
+    }
+
     return changed;
 }
 
@@ -76,7 +83,7 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
 
     // For each statement S in block n
     IRFragment::RTLIterator rit;
-    StatementList::iterator sit;
+    RTL::iterator sit;
     IRFragment *frag = proc->getDataFlow()->idxToFrag(n);
 
     for (SharedStmt stmt = frag->getFirstStmt(rit, sit); stmt; stmt = frag->getNextStmt(rit, sit)) {
@@ -113,7 +120,7 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
                 col = stmt->as<ReturnStatement>()->getCollector();
             }
 
-            col->updateDefs(stacks, proc);
+            col->updateDefs(stacks, proc, &m_defPool);
         }
 
         pushDefinitions(stmt, assumeABICompliance);
@@ -165,7 +172,7 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
     // (It is not important in Appel's algorithm, since he always pushes a definition
     // for every variable defined on the Stacks).
     IRFragment::RTLRIterator rrit;
-    StatementList::reverse_iterator srit;
+    RTL::reverse_iterator srit;
 
     for (SharedStmt S = frag->getLastStmt(rrit, srit); S; S = frag->getPrevStmt(rrit, srit)) {
         popDefinitions(S, assumeABICompliance);
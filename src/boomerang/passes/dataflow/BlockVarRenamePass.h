@@ -10,6 +10,7 @@
 #pragma once
 
 
+#include "boomerang/db/DefCollector.h"
 #include "boomerang/passes/Pass.h"
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/ssl/statements/Statement.h"
@@ -45,4 +46,7 @@ private:
 private:
     /// stores the last definition of a variable
     std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> stacks;
+
+    /// shares the definitions of collectors reached by the same definitions
+    DefCollectorPool m_defPool;
 };
@@ -28,14 +28,13 @@ GlobalConstReplacePass::GlobalConstReplacePass()
 
 bool GlobalConstReplacePass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     const BinaryImage *image      = proc->getProg()->getBinaryFile()->getImage();
     const BinarySymbolTable *syms = proc->getProg()->getBinaryFile()->getSymbols();
     bool changed                  = false;
 
-    for (SharedStmt st : stmts) {
+    for (const SharedStmt &st : *stmts) {
         std::shared_ptr<Assign> assgn = std::dynamic_pointer_cast<Assign>(st);
 
         if (assgn == nullptr) {
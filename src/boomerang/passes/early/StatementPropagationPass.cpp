@@ -20,6 +20,13 @@
 #include "boomerang/visitor/expvisitor/ExpDestCounter.h"
 #include "boomerang/visitor/stmtexpvisitor/StmtDestCounter.h"
 
+#include <algorithm>
+
+
+/// Procedures that exceeded their decompilation budget only propagate expressions
+/// up to this complexity to more than one destination.
+static constexpr const int DEGRADED_PROP_MAX_DEPTH = 1;
+
 
 StatementPropagationPass::StatementPropagationPass()
     : IPass("StatementPropagation", PassID::StatementPropagation)
@@ -29,14 +36,13 @@ StatementPropagationPass::StatementPropagationPass()
 
 bool StatementPropagationPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     // count the number of times each assignment LHS would be propagated somewhere
     std::map<SharedExp, int, lessExpStar> destCounts;
 
     // Also maintain a set of locations which are used by phi statements
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         ExpDestCounter edc(destCounts);
         StmtDestCounter sdc(&edc);
         s->accept(&sdc);
@@ -46,15 +52,19 @@ bool StatementPropagationPass::execute(UserProc *proc)
     // (these must be propagated even if it results in extra locals)
     bool change = false;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (!s->isPhi()) {
             change |= s->propagateFlagsToThis();
         }
     }
 
     // Finally the actual propagation
-    const int propMaxDepth = proc->getProg()->getProject()->getSettings()->propMaxDepth;
-    for (SharedStmt s : stmts) {
+    int propMaxDepth = proc->getProg()->getProject()->getSettings()->propMaxDepth;
+    if (proc->isDegraded()) {
+        propMaxDepth = std::min(propMaxDepth, DEGRADED_PROP_MAX_DEPTH);
+    }
+
+    for (const SharedStmt &s : *stmts) {
         if (!s->isPhi()) {
             change |= s->propagateToThis(propMaxDepth, &destCounts);
         }
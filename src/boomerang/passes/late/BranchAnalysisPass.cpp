@@ -157,10 +157,9 @@ bool BranchAnalysisPass::doBranchAnalysis(UserProc *proc)
 
 void BranchAnalysisPass::fixUglyBranches(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (auto stmt : stmts) {
+    for (const auto &stmt : *stmts) {
         if (!stmt->isBranch()) {
             continue;
         }
@@ -203,7 +202,7 @@ bool BranchAnalysisPass::isOnlyBranch(IRFragment *frag) const
         return false;
     }
 
-    StatementList::reverse_iterator sIt;
+    RTL::reverse_iterator sIt;
     IRFragment::RTLRIterator rIt;
     bool last = true;
 
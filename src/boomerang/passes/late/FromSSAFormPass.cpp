@@ -19,7 +19,9 @@
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/statements/PhiAssign.h"
 #include "boomerang/ssl/type/VoidType.h"
-#include "boomerang/util/ConnectionGraph.h"
+#include "boomerang/util/InterferenceGraph.h"
+#include "boomerang/util/OStream.h"
+#include "boomerang/util/UnionFind.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpCastInserter.h"
 #include "boomerang/visitor/expmodifier/ExpSSAXformer.h"
@@ -39,10 +41,9 @@ bool FromSSAFormPass::execute(UserProc *proc)
 {
     proc->getProg()->getProject()->alertDecompiling(proc);
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         // Map registers to initial local variables
         mapRegistersToLocals(s);
 
@@ -58,11 +59,13 @@ bool FromSSAFormPass::execute(UserProc *proc)
 
     FirstTypesMap firstTypes;
 
-    ConnectionGraph ig; // The interference graph; these can't have the same local variable
-    ConnectionGraph pu; // The Phi Unites: these need the same local variable or copies
+    // The interference graph; these can't have the same local variable.
+    // It also maps all SSA names to dense indices, which are used by the phi unites below.
+    InterferenceGraph ig;
+    UnionFind pu; // The Phi Unites: these need the same local variable or copies
     const bool assumeABICompliance = proc->getProg()->getProject()->getSettings()->assumeABI;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         LocationSet defs;
         s->getDefinitions(defs, assumeABICompliance);
 
@@ -79,6 +82,7 @@ bool FromSSAFormPass::execute(UserProc *proc)
 
             FirstTypesMap::iterator ff = firstTypes.find(defdByS);
             SharedExp ref              = RefExp::get(defdByS, s);
+            ig.insertNode(ref);
 
             if (ff == firstTypes.end()) {
                 // There is no first type yet. Record it.
@@ -107,26 +111,47 @@ bool FromSSAFormPass::execute(UserProc *proc)
 
     // Find the set of locations that are "united" by phi-functions
     // FIXME: are these going to be trivially predictable?
-    findPhiUnites(proc, pu);
+    findPhiUnites(proc, ig, pu);
+
+    // Group the phi unites by set, each set ordered by expression
+    std::map<std::size_t, std::vector<InterferenceGraph::NodeIndex>> phiUniteSets;
+
+    for (InterferenceGraph::NodeIndex idx : ig.getSortedNodes()) {
+        if (idx < pu.size()) {
+            phiUniteSets[pu.find(idx)].push_back(idx);
+        }
+    }
 
     if (proc->getProg()->getProject()->getSettings()->debugLiveness) {
         LOG_MSG("## ig interference graph:");
 
-        for (const auto &[from, to] : ig) {
+        for (const auto &[from, to] : ig.getSortedEdges()) {
             LOG_MSG("   ig %1 -> %2", from, to);
         }
 
         LOG_MSG("## pu phi unites graph:");
 
-        for (const auto &[from, to] : pu) {
-            LOG_MSG("   pu %1 -> %2", from, to);
+        for (const auto &entry : phiUniteSets) {
+            const std::vector<InterferenceGraph::NodeIndex> &members = entry.second;
+            if (members.size() < 2) {
+                continue;
+            }
+
+            QString tgt;
+            OStream os(&tgt);
+
+            for (InterferenceGraph::NodeIndex member : members) {
+                os << ig.getNode(member) << " ";
+            }
+
+            LOG_MSG("   pu %1", tgt);
         }
     }
 
     // Choose one of each interfering location to give a new name to
     assert(ig.allRefsHaveDefs());
 
-    for (const auto &[first, second] : ig) {
+    for (const auto &[first, second] : ig.getSortedEdges()) {
         auto ref1     = first->access<RefExp>();
         auto ref2     = second->access<RefExp>(); // r1 -> r2 and vice versa
         QString name1 = proc->lookupSymFromRefAny(ref1);
@@ -170,55 +195,44 @@ bool FromSSAFormPass::execute(UserProc *proc)
     // renaming. The rest of them will be done as phis are removed The idea is that where l1 and l2
     // have to unite, and exactly one of them already has a local/name, you can implement the
     // unification by giving the unnamed one the same name as the named one, as long as they don't
-    // interfere
-    for (const auto &[first, second] : pu) {
-        auto ref1     = first->access<RefExp>();
-        auto ref2     = second->access<RefExp>();
-        QString name1 = proc->lookupSymFromRef(ref1);
-        QString name2 = proc->lookupSymFromRef(ref2);
-
-        if (!name1.isEmpty() && !name2.isEmpty() && !ig.isConnected(ref1, *ref2)) {
-            // There is a case where this is unhelpful, and it happen in test/x86/fromssa2. We
-            // have renamed the destination of the phi to ebx_1, and that leaves the two phi
-            // operands as ebx. However, we attempt to unite them here, which will cause one of the
-            // operands to become ebx_1, so the neat oprimisation of replacing the phi with one copy
-            // doesn't work. The result is an extra copy. So check of r1 is a phi and r2 one of its
-            // operands, and all other operands for the phi have the same name. If so, don't rename.
-            SharedStmt def1 = ref1->getDef();
-
-            if (def1->isPhi()) {
-                bool allSame     = true;
-                bool r2IsOperand = false;
-                QString firstName;
-                std::shared_ptr<PhiAssign> pa = def1->as<PhiAssign>();
-
-                for (const std::shared_ptr<RefExp> &refExp : *pa) {
-                    auto re(RefExp::get(refExp->getSubExp1(), refExp->getDef()));
-
-                    if (*re == *ref2) {
-                        r2IsOperand = true;
-                    }
+    // interfere.
+    // Each set of united locations is coalesced into groups of locations sharing one name.
+    // A named location joins the first group of its set it does not interfere with. The first
+    // member of each group collects the interferences of all members, so checking one edge
+    // against it checks the whole group.
+    for (const auto &entry : phiUniteSets) {
+        const std::vector<InterferenceGraph::NodeIndex> &members = entry.second;
+        if (members.size() < 2) {
+            continue;
+        }
 
-                    if (firstName.isEmpty()) {
-                        firstName = proc->lookupSymFromRefAny(re);
-                    }
-                    else {
-                        QString tmp = proc->lookupSymFromRefAny(re);
+        std::vector<std::pair<InterferenceGraph::NodeIndex, QString>> groups;
 
-                        if (tmp.isEmpty() || (firstName != tmp)) {
-                            allSame = false;
-                            break;
-                        }
-                    }
-                }
+        for (InterferenceGraph::NodeIndex member : members) {
+            auto ref     = ig.getNode(member)->access<RefExp>();
+            QString name = proc->lookupSymFromRef(ref);
 
-                if (allSame && r2IsOperand) {
-                    continue; // This situation has happened, don't map now
+            if (name.isEmpty()) {
+                continue;
+            }
+
+            bool joined = false;
+
+            for (const auto &[groupIdx, groupName] : groups) {
+                if (ig.isConnected(groupIdx, member) ||
+                    keepsPhiOperandName(proc, ig.getNode(groupIdx)->access<RefExp>(), ref)) {
+                    continue;
                 }
+
+                proc->mapSymbolTo(ref, Location::local(groupName, proc));
+                ig.addNeighbours(groupIdx, member);
+                joined = true;
+                break;
             }
 
-            proc->mapSymbolTo(ref2, Location::local(name1, proc));
-            continue;
+            if (!joined) {
+                groups.push_back({ member, name });
+            }
         }
     }
 
@@ -243,7 +257,7 @@ bool FromSSAFormPass::execute(UserProc *proc)
     removeSubscriptsFromSymbols(proc);
     removeSubscriptsFromParameters(proc);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         // The last part of the fromSSA logic:
         // replace subscripted locations with suitable local variables
         ExpSSAXformer esx(proc);
@@ -260,10 +274,9 @@ bool FromSSAFormPass::execute(UserProc *proc)
 
 void FromSSAFormPass::nameParameterPhis(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt insn : stmts) {
+    for (const SharedStmt &insn : *stmts) {
         if (!insn->isPhi()) {
             continue; // Might be able to optimise this a bit
         }
@@ -372,26 +385,71 @@ void FromSSAFormPass::removeSubscriptsFromParameters(UserProc *proc)
 }
 
 
-void FromSSAFormPass::findPhiUnites(UserProc *proc, ConnectionGraph &pu)
+void FromSSAFormPass::findPhiUnites(UserProc *proc, InterferenceGraph &ig, UnionFind &pu)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : *stmts) {
         if (!stmt->isPhi()) {
             continue;
         }
 
         std::shared_ptr<PhiAssign> pa = stmt->as<PhiAssign>();
         SharedExp lhs                 = pa->getLeft();
-        auto reLhs                    = RefExp::get(lhs, pa);
+        const auto lhsIdx             = ig.insertNode(RefExp::get(lhs, pa));
 
         for (const std::shared_ptr<RefExp> &v : *pa) {
             assert(v->getSubExp1());
-            auto re = RefExp::get(v->getSubExp1(), v->getDef());
-            pu.connect(reLhs, re);
+            const auto opIdx = ig.insertNode(RefExp::get(v->getSubExp1(), v->getDef()));
+
+            pu.grow(ig.getNumNodes());
+            pu.unite(lhsIdx, opIdx);
+        }
+    }
+}
+
+
+bool FromSSAFormPass::keepsPhiOperandName(UserProc *proc, const std::shared_ptr<RefExp> &ref1,
+                                          const std::shared_ptr<RefExp> &ref2)
+{
+    // There is a case where uniting is unhelpful, and it happen in test/x86/fromssa2. We
+    // have renamed the destination of the phi to ebx_1, and that leaves the two phi
+    // operands as ebx. However, we attempt to unite them here, which will cause one of the
+    // operands to become ebx_1, so the neat oprimisation of replacing the phi with one copy
+    // doesn't work. The result is an extra copy. So check of r1 is a phi and r2 one of its
+    // operands, and all other operands for the phi have the same name. If so, don't rename.
+    SharedStmt def1 = ref1->getDef();
+
+    if (!def1->isPhi()) {
+        return false;
+    }
+
+    bool allSame     = true;
+    bool r2IsOperand = false;
+    QString firstName;
+    std::shared_ptr<PhiAssign> pa = def1->as<PhiAssign>();
+
+    for (const std::shared_ptr<RefExp> &refExp : *pa) {
+        auto re(RefExp::get(refExp->getSubExp1(), refExp->getDef()));
+
+        if (*re == *ref2) {
+            r2IsOperand = true;
+        }
+
+        if (firstName.isEmpty()) {
+            firstName = proc->lookupSymFromRefAny(re);
+        }
+        else {
+            QString tmp = proc->lookupSymFromRefAny(re);
+
+            if (tmp.isEmpty() || (firstName != tmp)) {
+                allSame = false;
+                break;
+            }
         }
     }
+
+    return allSame && r2IsOperand;
 }
 
 
@@ -419,10 +477,9 @@ void FromSSAFormPass::mapRegistersToLocals(const SharedStmt &stmt)
 
 void FromSSAFormPass::removePhis(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (!s->isPhi()) {
             continue;
         }
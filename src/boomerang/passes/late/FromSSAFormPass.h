@@ -14,7 +14,9 @@
 #include "boomerang/ssl/statements/Statement.h"
 
 
-class ConnectionGraph;
+class InterferenceGraph;
+class RefExp;
+class UnionFind;
 
 
 /// Transforms the statements a proc out of SSA form
@@ -46,8 +48,15 @@ private:
 
     void removeSubscriptsFromParameters(UserProc *proc);
 
-    /// Find the locations united by Phi-functions
-    void findPhiUnites(UserProc *proc, ConnectionGraph &pu);
+    /// Find the locations united by Phi-functions.
+    /// The locations are inserted into \p ig; their node indices are united in \p pu.
+    void findPhiUnites(UserProc *proc, InterferenceGraph &ig, UnionFind &pu);
+
+    /// \returns true if \p ref2 should keep its name instead of joining the name of \p ref1,
+    /// because \p ref1 is a phi, \p ref2 is one of its operands, and all operands
+    /// of the phi have the same name.
+    bool keepsPhiOperandName(UserProc *proc, const std::shared_ptr<RefExp> &ref1,
+                             const std::shared_ptr<RefExp> &ref2);
 
     void insertCastsForStmt(const SharedStmt &stmt);
 
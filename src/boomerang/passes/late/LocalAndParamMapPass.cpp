@@ -27,10 +27,9 @@ bool LocalAndParamMapPass::execute(UserProc *proc)
 {
     LOG_VERBOSE("### Mapping expressions to local variables for %1 ###", proc->getName());
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         DfaLocalMapper dlm(proc);
         StmtModifier sm(&dlm, true); // True to ignore def collector in return statement
 
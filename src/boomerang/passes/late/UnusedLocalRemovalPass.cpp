@@ -33,13 +33,12 @@ UnusedLocalRemovalPass::UnusedLocalRemovalPass()
 bool UnusedLocalRemovalPass::execute(UserProc *proc)
 {
     QSet<QString> usedLocals;
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     // First count any uses of the locals
     bool all = false;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         LocationSet locs;
         all |= addUsedLocalsForStmt(s, locs);
 
@@ -99,7 +98,7 @@ bool UnusedLocalRemovalPass::execute(UserProc *proc)
     // Remove any definitions of the removed locals
     const bool assumeABICompliance = proc->getProg()->getProject()->getSettings()->assumeABI;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         LocationSet ls;
         s->getDefinitions(ls, assumeABICompliance);
 
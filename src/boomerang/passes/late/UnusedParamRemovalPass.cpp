@@ -106,10 +106,7 @@ bool UnusedParamRemovalPass::checkForGainfulUse(UserProc *proc, SharedExp bparam
 {
     visited.insert(proc); // Prevent infinite recursion
 
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementRange()) {
         // Special checking for recursive calls
         if (s->isCall()) {
             std::shared_ptr<CallStatement> c = s->as<CallStatement>();
@@ -46,10 +46,9 @@ bool AssignRemovalPass::removeSpAssigns(UserProc *proc)
     SharedExp sp  = Location::regOf(Util::getStackRegisterIndex(proc->getProg()));
     bool foundone = false;
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : *stmts) {
         if (stmt->isAssign() && (*stmt->as<Assign>()->getLeft() == *sp)) {
             foundone = true;
         }
@@ -75,7 +74,7 @@ bool AssignRemovalPass::removeSpAssigns(UserProc *proc)
     proc->getProg()->getProject()->alertDecompileDebugPoint(
         proc, "Before removing stack pointer assigns.");
 
-    for (auto &stmt : stmts) {
+    for (const auto &stmt : *stmts) {
         if (stmt->isAssign()) {
             std::shared_ptr<Assign> a = stmt->as<Assign>();
 
@@ -99,10 +98,9 @@ bool AssignRemovalPass::removeMatchingAssigns(UserProc *proc, SharedExp e)
 
     bool foundone = false;
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (auto stmt : stmts) {
+    for (const auto &stmt : *stmts) {
         if (stmt->isAssign() && (*stmt->as<Assign>()->getLeft() == *e)) {
             foundone = true;
         }
@@ -139,7 +137,7 @@ bool AssignRemovalPass::removeMatchingAssigns(UserProc *proc, SharedExp e)
 
     proc->getProg()->getProject()->alertDecompileDebugPoint(proc, qPrintable(msg));
 
-    for (auto &stmt : stmts) {
+    for (const auto &stmt : *stmts) {
         if ((stmt)->isAssign()) {
             std::shared_ptr<Assign> a = stmt->as<Assign>();
 
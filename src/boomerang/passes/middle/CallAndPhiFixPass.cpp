@@ -55,13 +55,12 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
      * statement) do bypass and propagation for s
      */
     std::map<SharedExp, int, lessExpStar> destCounts;
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
     // a[m[]] hack, aint nothing better.
     bool found = true;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (!s->isCall()) {
             continue;
         }
@@ -102,7 +101,7 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
     // 26 r28 := r28{56}
     // So we can remove the second parameter,
     // then reduce the phi to an assignment, then propagate it
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (!s->isPhi()) {
             continue;
         }
@@ -114,7 +113,7 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
     }
 
     // Second pass
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (!s->isPhi()) { // Ordinary statement
             s->bypass();
             continue;
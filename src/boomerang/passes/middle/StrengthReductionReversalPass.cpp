@@ -26,10 +26,9 @@ StrengthReductionReversalPass::StrengthReductionReversalPass()
 
 bool StrengthReductionReversalPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    const auto stmts = proc->getStatementIndex();
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : *stmts) {
         if (!s->isAssign()) {
             continue;
         }
@@ -61,10 +60,7 @@ bool StrengthReductionReversalPass::execute(UserProc *proc)
                         first->as<Assign>()->getRight()->access<Const>()->getInt() == 0) {
                         // ok, fun, now we need to find every reference to p and
                         // replace with x{p} * c
-                        StatementList stmts2;
-                        proc->getStatements(stmts2);
-
-                        for (SharedStmt stmt2 : stmts2) {
+                        for (const SharedStmt &stmt2 : *stmts) {
                             if (stmt2 != as) {
                                 stmt2->searchAndReplace(
                                     *r, Binary::get(opMult, r->clone(), Const::get(c)));
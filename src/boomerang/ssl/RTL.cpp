@@ -71,6 +71,8 @@ RTL &RTL::operator=(const RTL &other)
 
 void RTL::deepCopyList(StmtList &dest) const
 {
+    dest.reserve(dest.size() + m_stmts.size());
+
     for (const SharedStmt &it : *this) {
         dest.push_back(it->clone());
     }
@@ -86,6 +88,8 @@ void RTL::append(const SharedStmt &s)
 
 void RTL::append(const StmtList &stmts)
 {
+    m_stmts.reserve(m_stmts.size() + stmts.size());
+
     for (const SharedStmt &stmt : stmts) {
         m_stmts.push_back(stmt->clone());
     }
@@ -849,7 +849,7 @@ std::unique_ptr<StatementList> CallStatement::calcResults() const
         const auto sig  = m_proc->getSignature();
         const RegNum sp = sig->getStackRegister();
 
-        for (SharedExp loc : m_useCol) {
+        for (SharedExp loc : m_useCol.getUses()) {
             if (!m_proc->canBeReturn(loc)) {
                 continue; // Ignore filtered locations
             }
@@ -214,7 +214,7 @@ bool ReturnStatement::accept(StmtExpVisitor *v)
     }
 
     if (!v->isIgnoreCol()) {
-        for (SharedStmt stmt : m_col) {
+        for (SharedStmt stmt : m_col.getDefs()) {
             if (!stmt->accept(v)) {
                 return false;
             }
@@ -407,7 +407,7 @@ void ReturnStatement::updateModifieds()
     // modifieds, which will be filtered and sorted to become the new modifieds Ick... O(N*M)
     // (N existing modifeds, M collected locations)
 
-    for (SharedStmt stmt : m_col) {
+    for (SharedStmt stmt : m_col.getDefs()) {
         bool found                   = false;
         std::shared_ptr<Assign> asgn = stmt->as<Assign>();
         SharedExp colLhs             = asgn->getLeft();
@@ -150,6 +150,8 @@ public:
     /// Changes the procedure this statement is part of.
     void setProc(UserProc *p);
 
+    /// \returns the number of this statement for display, as set by
+    /// \ref UserProc::numberStatements. Use \ref getID to identify statements.
     int getNumber() const { return m_number; }
 
     /// Overridden for calls (and maybe later returns)
@@ -0,0 +1,203 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BytePatternTrie.h"
+
+#include "boomerang/util/log/Log.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <utility>
+
+
+/// Denotes a wildcard byte in a parsed pattern
+static constexpr const int WILDCARD_BYTE = -1;
+
+
+/// Parse a pattern like "5589E5..". \returns false if \p pattern is malformed.
+static bool parsePattern(const QString &pattern, std::vector<int> &bytes)
+{
+    if (pattern.isEmpty() || pattern.length() % 2 != 0) {
+        return false;
+    }
+
+    bytes.clear();
+    bytes.reserve(pattern.length() / 2);
+
+    for (int i = 0; i < pattern.length(); i += 2) {
+        const QString byteStr = pattern.mid(i, 2);
+
+        if (byteStr == "..") {
+            bytes.push_back(WILDCARD_BYTE);
+            continue;
+        }
+
+        bool ok              = false;
+        const uint byteValue = byteStr.toUInt(&ok, 16);
+        if (!ok) {
+            return false;
+        }
+
+        bytes.push_back(static_cast<int>(byteValue));
+    }
+
+    return true;
+}
+
+
+BytePatternTrie::BytePatternTrie()
+{
+    clear();
+}
+
+
+bool BytePatternTrie::addPattern(const QString &pattern, const QString &name)
+{
+    std::vector<int> bytes;
+    if (name.isEmpty() || !parsePattern(pattern, bytes)) {
+        return false;
+    }
+
+    const int numFixedBytes = std::count_if(bytes.begin(), bytes.end(),
+                                            [](int byte) { return byte != WILDCARD_BYTE; });
+    if (numFixedBytes < MIN_FIXED_BYTES) {
+        return false;
+    }
+
+    NodeIndex nodeIdx = 0;
+    for (int byte : bytes) {
+        nodeIdx = getOrCreateChild(nodeIdx, byte);
+    }
+
+    Node &node = m_nodes[nodeIdx];
+    if (node.name.isEmpty()) {
+        node.name = name;
+        m_numPatterns++;
+        m_maxLength = std::max(m_maxLength, bytes.size());
+    }
+    else if (node.name != name) {
+        // The same bytes belong to several functions; we cannot tell them apart.
+        node.isAmbiguous = true;
+    }
+
+    return true;
+}
+
+
+int BytePatternTrie::readPatternFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        return -1;
+    }
+
+    QTextStream stream(&file);
+    int numAdded = 0;
+    int lineNum  = 0;
+
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine().simplified();
+        lineNum++;
+
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const int sep = line.indexOf(' ');
+        if (sep == -1 || !addPattern(line.left(sep), line.mid(sep + 1))) {
+            LOG_WARN("Ignoring invalid pattern in line %1 of '%2'", lineNum, filePath);
+            continue;
+        }
+
+        numAdded++;
+    }
+
+    return numAdded;
+}
+
+
+void BytePatternTrie::clear()
+{
+    m_nodes.clear();
+    m_nodes.emplace_back();
+
+    m_numPatterns = 0;
+    m_maxLength   = 0;
+}
+
+
+QString BytePatternTrie::match(const Byte *data, std::size_t size) const
+{
+    QString bestName;
+    std::size_t bestLength = 0;
+    bool isAmbiguous       = false;
+
+    // (node, number of bytes matched to reach the node)
+    std::vector<std::pair<NodeIndex, std::size_t>> toVisit = { { 0, 0 } };
+
+    while (!toVisit.empty()) {
+        const auto [nodeIdx, depth] = toVisit.back();
+        toVisit.pop_back();
+
+        const Node &node = m_nodes[nodeIdx];
+
+        if (!node.name.isEmpty()) {
+            if (depth > bestLength) {
+                bestName    = node.name;
+                bestLength  = depth;
+                isAmbiguous = node.isAmbiguous;
+            }
+            else if (depth == bestLength && (node.isAmbiguous || node.name != bestName)) {
+                isAmbiguous = true;
+            }
+        }
+
+        if (depth == size) {
+            continue;
+        }
+
+        auto it = node.children.find(data[depth]);
+        if (it != node.children.end()) {
+            toVisit.push_back({ it->second, depth + 1 });
+        }
+
+        if (node.wildcard != NODE_INVALID) {
+            toVisit.push_back({ node.wildcard, depth + 1 });
+        }
+    }
+
+    return isAmbiguous ? QString() : bestName;
+}
+
+
+BytePatternTrie::NodeIndex BytePatternTrie::getOrCreateChild(NodeIndex parent, int byte)
+{
+    if (byte == WILDCARD_BYTE) {
+        if (m_nodes[parent].wildcard == NODE_INVALID) {
+            const NodeIndex child = m_nodes.size();
+            m_nodes.emplace_back(); // invalidates references into m_nodes
+            m_nodes[parent].wildcard = child;
+        }
+
+        return m_nodes[parent].wildcard;
+    }
+
+    auto it = m_nodes[parent].children.find(static_cast<Byte>(byte));
+    if (it != m_nodes[parent].children.end()) {
+        return it->second;
+    }
+
+    const NodeIndex child = m_nodes.size();
+    m_nodes.emplace_back();
+    m_nodes[parent].children[static_cast<Byte>(byte)] = child;
+
+    return child;
+}
@@ -0,0 +1,93 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <map>
+#include <vector>
+
+
+/**
+ * A prefix trie of named byte patterns, used to recognize statically linked library functions
+ * by the bytes at their entry point (similar to IDA's FLIRT).
+ * Patterns may contain wildcard bytes for bytes that differ between binaries linking
+ * the same function, like relocated addresses.
+ *
+ * A pattern is written as a string of hexadecimal bytes where ".." denotes a wildcard byte,
+ * e.g. "5589E583EC..A1........".
+ * Matching follows both the exact and the wildcard edge of each node, so the time needed
+ * for a match only depends on the length of the patterns, not on their number.
+ */
+class BOOMERANG_API BytePatternTrie
+{
+public:
+    /// Patterns with fewer non-wildcard bytes are too likely to match unrelated functions.
+    static constexpr const int MIN_FIXED_BYTES = 8;
+
+public:
+    BytePatternTrie();
+
+public:
+    /**
+     * Add a pattern for the function named \p name.
+     * \returns false if \p pattern is malformed or has fewer than \ref MIN_FIXED_BYTES
+     * non-wildcard bytes.
+     */
+    bool addPattern(const QString &pattern, const QString &name);
+
+    /**
+     * Read all patterns from the file at \p filePath.
+     * Each line contains a pattern and the name of the function, separated by whitespace.
+     * Empty lines and lines starting with '#' are ignored.
+     * \returns the number of patterns added, or -1 if the file could not be read.
+     */
+    int readPatternFile(const QString &filePath);
+
+    /// Remove all patterns.
+    void clear();
+
+    bool isEmpty() const { return m_numPatterns == 0; }
+    std::size_t getNumPatterns() const { return m_numPatterns; }
+
+    /// \returns the length of the longest pattern in bytes
+    std::size_t getMaxPatternLength() const { return m_maxLength; }
+
+    /**
+     * \returns the name of the function whose pattern matches the start of \p data.
+     * If several patterns match, the longest one wins. If the longest match is ambiguous,
+     * i.e. patterns of the same length for different functions match, an empty string is
+     * returned, as it is when no pattern matches.
+     */
+    QString match(const Byte *data, std::size_t size) const;
+
+private:
+    typedef std::size_t NodeIndex;
+    static constexpr const NodeIndex NODE_INVALID = NodeIndex(-1);
+
+    struct Node
+    {
+        std::map<Byte, NodeIndex> children;
+        NodeIndex wildcard = NODE_INVALID; ///< Child for a wildcard byte
+        QString name;                      ///< Function name if a pattern ends here
+        bool isAmbiguous = false;          ///< Patterns for different functions end here
+    };
+
+    NodeIndex getOrCreateChild(NodeIndex parent, int byte);
+
+private:
+    std::vector<Node> m_nodes; ///< m_nodes[0] is the root
+    std::size_t m_numPatterns = 0;
+    std::size_t m_maxLength   = 0;
+};
@@ -0,0 +1,197 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "InterferenceGraph.h"
+
+#include "boomerang/ssl/exp/RefExp.h"
+
+#include <algorithm>
+
+
+/// Graphs with more nodes than this do not use a bit matrix (4096 nodes -> 2 MiB).
+static constexpr const std::size_t MAX_MATRIX_NODES = 4096;
+
+
+InterferenceGraph::NodeIndex InterferenceGraph::insertNode(const SharedExp &exp)
+{
+    auto it = m_nodeIndices.find(exp);
+    if (it != m_nodeIndices.end()) {
+        return it->second;
+    }
+
+    const NodeIndex idx = m_nodes.size();
+    m_nodes.push_back(exp);
+    m_nodeIndices.insert({ exp, idx });
+    m_neighbours.emplace_back();
+    reserveNodes(m_nodes.size());
+
+    return idx;
+}
+
+
+InterferenceGraph::NodeIndex InterferenceGraph::findNode(const SharedExp &exp) const
+{
+    auto it = m_nodeIndices.find(exp);
+    return it != m_nodeIndices.end() ? it->second : NODE_INVALID;
+}
+
+
+std::vector<InterferenceGraph::NodeIndex> InterferenceGraph::getSortedNodes() const
+{
+    std::vector<NodeIndex> result;
+    result.reserve(m_nodeIndices.size());
+
+    for (const auto &entry : m_nodeIndices) {
+        result.push_back(entry.second);
+    }
+
+    return result;
+}
+
+
+bool InterferenceGraph::add(const SharedExp &a, const SharedExp &b)
+{
+    const NodeIndex idxA = insertNode(a);
+    const NodeIndex idxB = insertNode(b);
+
+    return addEdge(idxA, idxB);
+}
+
+
+void InterferenceGraph::connect(const SharedExp &a, const SharedExp &b)
+{
+    const NodeIndex idxA = insertNode(a);
+    const NodeIndex idxB = insertNode(b);
+
+    // if a is connected to c,d and e, 'b' should also be connected to c,d and e
+    const std::vector<NodeIndex> aNeighbours = m_neighbours[idxA];
+    const std::vector<NodeIndex> bNeighbours = m_neighbours[idxB];
+
+    addEdge(idxA, idxB);
+
+    for (NodeIndex e : bNeighbours) {
+        addEdge(idxA, e);
+    }
+
+    for (NodeIndex e : aNeighbours) {
+        addEdge(e, idxB);
+    }
+}
+
+
+void InterferenceGraph::addNeighbours(NodeIndex to, NodeIndex from)
+{
+    const std::vector<NodeIndex> fromNeighbours = m_neighbours[from];
+
+    for (NodeIndex e : fromNeighbours) {
+        if (e != from) {
+            addEdge(to, e);
+        }
+    }
+}
+
+
+bool InterferenceGraph::isConnected(const SharedExp &a, const SharedExp &b) const
+{
+    const NodeIndex idxA = findNode(a);
+    const NodeIndex idxB = findNode(b);
+
+    return idxA != NODE_INVALID && idxB != NODE_INVALID && isConnected(idxA, idxB);
+}
+
+
+bool InterferenceGraph::isConnected(NodeIndex a, NodeIndex b) const
+{
+    if (m_useMatrix) {
+        return m_matrix[a * m_matrixNodes + b];
+    }
+
+    if (m_neighbours[a].size() > m_neighbours[b].size()) {
+        std::swap(a, b);
+    }
+
+    const std::vector<NodeIndex> &neighbours = m_neighbours[a];
+    return std::find(neighbours.begin(), neighbours.end(), b) != neighbours.end();
+}
+
+
+bool InterferenceGraph::allRefsHaveDefs() const
+{
+    for (const SharedExp &node : m_nodes) {
+        if (node->isSubscript() && !node->access<RefExp>()->getDef()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+std::vector<std::pair<SharedExp, SharedExp>> InterferenceGraph::getSortedEdges() const
+{
+    std::vector<std::pair<SharedExp, SharedExp>> result;
+
+    for (NodeIndex from : getSortedNodes()) {
+        for (NodeIndex to : m_neighbours[from]) {
+            result.push_back({ m_nodes[from], m_nodes[to] });
+
+            if (from == to) {
+                // a self-connection is one edge in each direction
+                result.push_back({ m_nodes[from], m_nodes[to] });
+            }
+        }
+    }
+
+    return result;
+}
+
+
+bool InterferenceGraph::addEdge(NodeIndex a, NodeIndex b)
+{
+    if (isConnected(a, b)) {
+        return false; // Don't add a second entry
+    }
+
+    if (m_useMatrix) {
+        m_matrix[a * m_matrixNodes + b] = true;
+        m_matrix[b * m_matrixNodes + a] = true;
+    }
+
+    m_neighbours[a].push_back(b);
+    if (a != b) {
+        m_neighbours[b].push_back(a);
+    }
+
+    return true;
+}
+
+
+void InterferenceGraph::reserveNodes(std::size_t numNodes)
+{
+    if (!m_useMatrix || numNodes <= m_matrixNodes) {
+        return;
+    }
+    else if (numNodes > MAX_MATRIX_NODES) {
+        // Only use the neighbour vectors from now on
+        m_useMatrix   = false;
+        m_matrixNodes = 0;
+        m_matrix      = std::vector<bool>();
+        return;
+    }
+
+    // Grow the matrix and re-insert all edges
+    m_matrixNodes = std::min(std::max<std::size_t>(64, 2 * numNodes), MAX_MATRIX_NODES);
+    m_matrix.assign(m_matrixNodes * m_matrixNodes, false);
+
+    for (NodeIndex idx = 0; idx < m_neighbours.size(); ++idx) {
+        for (NodeIndex neighbour : m_neighbours[idx]) {
+            m_matrix[idx * m_matrixNodes + neighbour] = true;
+        }
+    }
+}
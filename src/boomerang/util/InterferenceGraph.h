@@ -0,0 +1,95 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+
+#include <map>
+#include <vector>
+
+
+/**
+ * An undirected graph of interferences between expressions (usually SSA names).
+ * Each expression is mapped to a dense index once; edges are stored by index.
+ *
+ * \internal The neighbours of each node are stored in insertion order.
+ * Small graphs additionally store the edges in a bit matrix, as suggested by Appel,
+ * to answer \ref isConnected in constant time. Larger graphs search the neighbours
+ * of the node with fewer neighbours instead, since the matrix would grow quadratically.
+ * Edges cannot be removed.
+ */
+class BOOMERANG_API InterferenceGraph
+{
+public:
+    typedef std::size_t NodeIndex;
+    static constexpr const NodeIndex NODE_INVALID = NodeIndex(-1);
+
+public:
+    /// \returns the index of \p exp. If \p exp is not in the graph yet, it is inserted.
+    NodeIndex insertNode(const SharedExp &exp);
+
+    /// \returns the index of \p exp, or NODE_INVALID if \p exp is not in the graph.
+    NodeIndex findNode(const SharedExp &exp) const;
+
+    const SharedExp &getNode(NodeIndex idx) const { return m_nodes[idx]; }
+    std::size_t getNumNodes() const { return m_nodes.size(); }
+
+    /// \returns the indices of all nodes, ordered by the expressions of the nodes.
+    std::vector<NodeIndex> getSortedNodes() const;
+
+    /// Add an edge between \p a and \p b, inserting the nodes if necessary.
+    /// \returns true if the edge did not exist before
+    bool add(const SharedExp &a, const SharedExp &b);
+
+    /**
+     * Connect all neighbours of \p a to \p b and
+     * connect all neighbours of \p b to \p a
+     */
+    void connect(const SharedExp &a, const SharedExp &b);
+
+    /// Connect all neighbours of \p from to \p to, such that \p to interferes
+    /// with everything \p from interferes with.
+    void addNeighbours(NodeIndex to, NodeIndex from);
+
+    /// \returns true if \p a is connected to \p b
+    bool isConnected(const SharedExp &a, const SharedExp &b) const;
+    bool isConnected(NodeIndex a, NodeIndex b) const;
+
+    /**
+     * For all \ref RefExp expression in this graph,
+     * check if they have definitions.
+     */
+    bool allRefsHaveDefs() const;
+
+    /**
+     * \returns all edges in both directions. The edges are ordered by their first expression;
+     * edges with equal first expressions are ordered by insertion.
+     * Self-connections are returned twice.
+     */
+    std::vector<std::pair<SharedExp, SharedExp>> getSortedEdges() const;
+
+private:
+    bool addEdge(NodeIndex a, NodeIndex b);
+
+    /// Make sure edges between \p numNodes nodes can be stored
+    void reserveNodes(std::size_t numNodes);
+
+private:
+    std::vector<SharedExp> m_nodes;                            ///< Maps index -> expression
+    std::map<SharedExp, NodeIndex, lessExpStar> m_nodeIndices; ///< Maps expression -> index
+
+    /// Neighbours of each node, in insertion order
+    std::vector<std::vector<NodeIndex>> m_neighbours;
+
+    bool m_useMatrix          = true;
+    std::size_t m_matrixNodes = 0; ///< Number of nodes the matrix has room for
+    std::vector<bool> m_matrix;    ///< Adjacency bit matrix (only if m_useMatrix)
+};
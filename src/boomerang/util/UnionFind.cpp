@@ -0,0 +1,59 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "UnionFind.h"
+
+#include <cassert>
+#include <utility>
+
+
+UnionFind::UnionFind(std::size_t size)
+{
+    grow(size);
+}
+
+
+void UnionFind::grow(std::size_t newSize)
+{
+    for (std::size_t elem = m_parent.size(); elem < newSize; ++elem) {
+        m_parent.push_back(elem);
+        m_setSize.push_back(1);
+    }
+}
+
+
+std::size_t UnionFind::find(std::size_t elem)
+{
+    assert(elem < m_parent.size());
+
+    while (m_parent[elem] != elem) {
+        m_parent[elem] = m_parent[m_parent[elem]];
+        elem           = m_parent[elem];
+    }
+
+    return elem;
+}
+
+
+bool UnionFind::unite(std::size_t a, std::size_t b)
+{
+    a = find(a);
+    b = find(b);
+
+    if (a == b) {
+        return false;
+    }
+    else if (m_setSize[a] < m_setSize[b]) {
+        std::swap(a, b);
+    }
+
+    m_parent[b] = a;
+    m_setSize[a] += m_setSize[b];
+    return true;
+}
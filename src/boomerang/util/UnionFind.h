@@ -0,0 +1,48 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+ * Disjoint sets of the integers 0..size()-1 (union-find data structure).
+ * Uses union by size and path halving, so all operations take
+ * almost constant amortized time.
+ */
+class BOOMERANG_API UnionFind
+{
+public:
+    explicit UnionFind(std::size_t size = 0);
+
+public:
+    std::size_t size() const { return m_parent.size(); }
+
+    /// Add singleton sets until there are \p newSize elements.
+    void grow(std::size_t newSize);
+
+    /// \returns the representative of the set containing \p elem
+    std::size_t find(std::size_t elem);
+
+    /// Merge the sets containing \p a and \p b.
+    /// \returns false if \p a and \p b were already in the same set
+    bool unite(std::size_t a, std::size_t b);
+
+    /// \returns true if \p a and \p b are in the same set
+    bool isSameSet(std::size_t a, std::size_t b) { return find(a) == find(b); }
+
+private:
+    std::vector<std::size_t> m_parent;
+    std::vector<std::size_t> m_setSize; ///< Size of the set (only valid for representatives)
+};
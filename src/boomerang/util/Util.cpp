@@ -20,6 +20,20 @@
 #include <cassert>
 #include <string>
 
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+#    define PSAPI_VERSION 2 // use K32GetProcessMemoryInfo from kernel32.dll
+#    include "Windows.h"
+#    include <Psapi.h>
+#elif defined(__APPLE__)
+#    include <mach/mach.h>
+#    include <sys/resource.h>
+#else
+#    include <sys/resource.h>
+#    include <unistd.h>
+
+#    include <cstdio>
+#endif
+
 
 namespace Util
 {
@@ -109,4 +123,69 @@ int getStackRegisterIndex(const Prog *prog)
     default: return -1;
     }
 }
+
+
+std::size_t getPeakMemoryUsage()
+{
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+
+    return counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#    if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss); // bytes
+#    else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // KiB
+#    endif
+#endif
+}
+
+
+std::size_t getCurrentMemoryUsage()
+{
+#if defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+
+    return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+        return 0;
+    }
+
+    return info.resident_size;
+#else
+    // The second field of /proc/self/statm is the number of resident pages
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0;
+    }
+
+    long totalPages    = 0;
+    long residentPages = 0;
+    const int numRead  = std::fscanf(statm, "%ld %ld", &totalPages, &residentPages);
+    std::fclose(statm);
+
+    if (numRead != 2) {
+        return 0;
+    }
+
+    const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return static_cast<std::size_t>(residentPages) * pageSize;
+#endif
+}
 }
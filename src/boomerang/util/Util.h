@@ -95,4 +95,17 @@ int getStackOffset(SharedConstExp e, int sp);
  * of an architecture, or -1 if the architecture does not have a stack register.
  */
 BOOMERANG_API int getStackRegisterIndex(const Prog *prog);
+
+
+/**
+ * \returns the peak resident set size (high-water mark of physical memory usage)
+ * of the current process in bytes, or 0 if it cannot be determined on this platform.
+ */
+BOOMERANG_API std::size_t getPeakMemoryUsage();
+
+/**
+ * \returns the current resident set size (physical memory usage) of the current process
+ * in bytes, or 0 if it cannot be determined on this platform.
+ */
+BOOMERANG_API std::size_t getCurrentMemoryUsage();
 }
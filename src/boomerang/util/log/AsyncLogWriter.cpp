@@ -0,0 +1,186 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "AsyncLogWriter.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+
+
+/// Number of times the writer thread yields before it starts sleeping when the queue is empty
+static constexpr const int MAX_IDLE_YIELDS = 100;
+
+
+AsyncLogWriter::AsyncLogWriter(std::size_t capacity, LogOverflowPolicy policy, WriteFunc write,
+                               FlushFunc flush)
+    : m_policy(policy)
+    , m_write(std::move(write))
+    , m_flush(std::move(flush))
+    , m_mask(capacity - 1)
+    , m_slots(new Slot[capacity])
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+    , m_numFlushed(0)
+    , m_numDropped(0)
+    , m_stopRequested(false)
+{
+    assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+    for (std::size_t i = 0; i < capacity; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_thread = std::thread(&AsyncLogWriter::run, this);
+}
+
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    m_stopRequested.store(true, std::memory_order_release);
+    m_thread.join();
+}
+
+
+bool AsyncLogWriter::push(LogRecord record)
+{
+    if (tryPush(record)) {
+        return true;
+    }
+    else if (m_policy == LogOverflowPolicy::Drop) {
+        m_numDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    do {
+        std::this_thread::yield();
+    } while (!tryPush(record));
+
+    return true;
+}
+
+
+void AsyncLogWriter::flush()
+{
+    // All records in slots claimed up to now will be written eventually,
+    // even if their producers have not finished writing them to the slot yet.
+    const std::size_t numPushed = m_enqueuePos.load(std::memory_order_acquire);
+
+    while (m_numFlushed.load(std::memory_order_acquire) < numPushed) {
+        std::this_thread::yield();
+    }
+}
+
+
+bool AsyncLogWriter::tryPush(LogRecord &record)
+{
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot *slot      = nullptr;
+
+    for (;;) {
+        slot                       = &m_slots[pos & m_mask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff  = static_cast<std::ptrdiff_t>(sequence - pos);
+
+        if (diff == 0) {
+            // The slot is free; try to claim it.
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return false; // The consumer has not freed the slot yet -> queue is full
+        }
+        else {
+            // Another producer claimed the slot before us
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = std::move(record);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+
+bool AsyncLogWriter::tryPop(LogRecord &record)
+{
+    // There is only a single consumer, so the dequeue position can be updated without CAS.
+    const std::size_t pos      = m_dequeuePos.load(std::memory_order_relaxed);
+    Slot &slot                 = m_slots[pos & m_mask];
+    const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+    if (sequence != pos + 1) {
+        return false; // empty, or the producer is still writing the record
+    }
+
+    record = std::move(slot.record);
+    slot.record.msg.clear();
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+}
+
+
+void AsyncLogWriter::run()
+{
+    std::size_t numWritten      = 0;
+    std::size_t numFlushed      = 0;
+    std::size_t numDropReported = 0;
+    int numIdle                 = 0;
+
+    LogRecord record;
+
+    for (;;) {
+        // Read the stop flag before looking at the queue, so that all records
+        // pushed before the stop request are written.
+        const bool stopRequested = m_stopRequested.load(std::memory_order_acquire);
+
+        if (tryPop(record)) {
+            m_write(record);
+            numWritten++;
+            numIdle = 0;
+            continue;
+        }
+
+        // The queue is empty, so this is a good time to do the expensive stuff.
+        bool needFlush = numFlushed != numWritten;
+
+        const std::size_t numDropped = m_numDropped.load(std::memory_order_relaxed);
+        if (numDropped != numDropReported) {
+            LogRecord dropRecord;
+            dropRecord.level = LogLevel::Warning;
+            dropRecord.file  = __FILE__;
+            dropRecord.line  = __LINE__;
+            dropRecord.msg   = QString("%1 log messages were dropped because the queue was full")
+                                 .arg(numDropped - numDropReported);
+            m_write(dropRecord);
+
+            numDropReported = numDropped;
+            needFlush       = true;
+        }
+
+        if (needFlush) {
+            m_flush();
+            numFlushed = numWritten;
+            m_numFlushed.store(numFlushed, std::memory_order_release);
+        }
+
+        if (stopRequested) {
+            break;
+        }
+        else if (numIdle < MAX_IDLE_YIELDS) {
+            numIdle++;
+            std::this_thread::yield();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/log/Log.h"
+
+#include <QString>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+
+/// A log message that has not been written to the log sinks yet.
+struct BOOMERANG_API LogRecord
+{
+    LogLevel level   = LogLevel::Default;
+    const char *file = nullptr;
+    int line         = 0;
+    QString msg;
+    bool splitLines = true; ///< If true, each line of \p msg is written as a separate message
+};
+
+
+/**
+ * Writes log records to the log sinks on a background thread.
+ * Records are passed to the writer thread through a bounded lock-free ring buffer,
+ * so logging threads never wait for I/O, and never take a lock.
+ * If the ring buffer is full, the record is either dropped or the logging thread
+ * waits for a free slot, depending on the overflow policy.
+ *
+ * Any number of threads may push records concurrently. Records pushed by the same thread
+ * are written in the order they were pushed.
+ *
+ * \internal The ring buffer is the bounded queue by Dmitry Vyukov: Each slot has
+ * a sequence number that tells producers and the consumer whether the slot is free or used,
+ * so producers only need a single compare-and-swap to claim a slot.
+ */
+class BOOMERANG_API AsyncLogWriter
+{
+public:
+    /// Formats and writes a single record to the log sinks. Called on the writer thread.
+    typedef std::function<void(const LogRecord &)> WriteFunc;
+
+    /// Flushes all log sinks. Called on the writer thread.
+    typedef std::function<void()> FlushFunc;
+
+public:
+    /// \param capacity maximum number of queued records; must be a power of 2.
+    AsyncLogWriter(std::size_t capacity, LogOverflowPolicy policy, WriteFunc write,
+                   FlushFunc flush);
+    AsyncLogWriter(const AsyncLogWriter &other) = delete;
+    AsyncLogWriter(AsyncLogWriter &&other)      = delete;
+
+    /// Writes all queued records and stops the writer thread.
+    ~AsyncLogWriter();
+
+    AsyncLogWriter &operator=(const AsyncLogWriter &other) = delete;
+    AsyncLogWriter &operator=(AsyncLogWriter &&other) = delete;
+
+public:
+    /**
+     * Queue \p record for writing. Thread safe.
+     * \returns false if the record was dropped because the queue is full.
+     */
+    bool push(LogRecord record);
+
+    /// Wait until all records pushed so far are written and the log sinks are flushed.
+    void flush();
+
+    /// \returns the total number of records dropped because the queue was full.
+    std::size_t getNumDropped() const { return m_numDropped.load(std::memory_order_relaxed); }
+
+private:
+    bool tryPush(LogRecord &record);
+    bool tryPop(LogRecord &record);
+
+    /// Main loop of the writer thread
+    void run();
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    const LogOverflowPolicy m_policy;
+    const WriteFunc m_write;
+    const FlushFunc m_flush;
+
+    const std::size_t m_mask; ///< capacity - 1
+    std::unique_ptr<Slot[]> m_slots;
+
+    // Keep the positions of producers and consumer on separate cache lines
+    alignas(64) std::atomic<std::size_t> m_enqueuePos;
+    alignas(64) std::atomic<std::size_t> m_dequeuePos;
+
+    /// Number of records written and flushed to the sinks by the writer thread
+    alignas(64) std::atomic<std::size_t> m_numFlushed;
+    std::atomic<std::size_t> m_numDropped;
+    std::atomic<bool> m_stopRequested;
+
+    std::thread m_thread;
+};
@@ -15,6 +15,7 @@
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/Util.h"
+#include "boomerang/util/log/AsyncLogWriter.h"
 #include "boomerang/util/log/ConsoleLogSink.h"
 #include "boomerang/util/log/FileLogSink.h"
 
@@ -41,7 +42,8 @@ Log::Log(LogLevel level)
 
 Log::~Log()
 {
-    flush();
+    m_writer.reset();
+    flushSinks();
 }
 
 
@@ -57,27 +59,96 @@ Log &Log::getOrCreateLog()
 
 void Log::flush()
 {
-    for (std::unique_ptr<ILogSink> &s : m_sinks) {
-        s->flush();
+    if (m_writer) {
+        m_writer->flush();
+    }
+    else {
+        flushSinks();
+    }
+}
+
+
+void Log::setAsyncMode(bool async, LogOverflowPolicy policy, std::size_t capacity)
+{
+    // writes all queued messages
+    m_writer.reset();
+
+    if (async) {
+        m_writer = std::make_unique<AsyncLogWriter>(
+            capacity, policy, [this](const LogRecord &record) { writeRecord(record); },
+            [this]() { flushSinks(); });
     }
 }
 
 
 void Log::log(LogLevel level, const char *file, int line, const QString &msg)
 {
-    const QStringList msgLines = msg.split('\n');
+    if (!canLog(level)) {
+        return;
+    }
 
-    for (const QString &msgLine : msgLines) {
-        if (canLog(level)) {
-            logDirect(level, file, line, msgLine);
-        }
+    LogRecord record;
+    record.level      = level;
+    record.file       = file;
+    record.line       = line;
+    record.msg        = msg;
+    record.splitLines = true;
+
+    if (m_writer) {
+        m_writer->push(std::move(record));
+    }
+    else {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        writeRecord(record);
+        flushSinks();
     }
 
-    flush();
+    if (level == LogLevel::Fatal) {
+        flush();
+        abort();
+    }
 }
 
 
 void Log::logDirect(LogLevel level, const char *file, int line, const QString &msg)
+{
+    if (m_writer) {
+        LogRecord record;
+        record.level      = level;
+        record.file       = file;
+        record.line       = line;
+        record.msg        = msg;
+        record.splitLines = false;
+        m_writer->push(std::move(record));
+    }
+    else {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        writeLine(level, file, line, msg);
+    }
+
+    if (level == LogLevel::Fatal) {
+        flush();
+        abort();
+    }
+}
+
+
+void Log::writeRecord(const LogRecord &record)
+{
+    if (!record.splitLines) {
+        writeLine(record.level, record.file, record.line, record.msg);
+        return;
+    }
+
+    const QStringList msgLines = record.msg.split('\n');
+
+    for (const QString &msgLine : msgLines) {
+        writeLine(record.level, record.file, record.line, msgLine);
+    }
+}
+
+
+void Log::writeLine(LogLevel level, const char *file, int line, const QString &msg)
 {
     char prettyFile[40]; // truncated file name
     truncateFileName(prettyFile, 40, file);
@@ -89,10 +160,6 @@ void Log::logDirect(LogLevel level, const char *file, int line, const QString &m
 
     const QString pattern = "%1 | %2 | %3 | %4\n";
     this->write(pattern.arg(levelToString(level)).arg(prettyFilePath).arg(line, 4).arg(msg));
-
-    if (level == LogLevel::Fatal) {
-        abort();
-    }
 }
 
 
@@ -100,15 +167,20 @@ void Log::addLogSink(std::unique_ptr<ILogSink> s)
 {
     assert(s != nullptr);
 
+    // Make sure the writer thread does not use the sinks while we modify them
+    flush();
+
     if (std::find(m_sinks.begin(), m_sinks.end(), s) == m_sinks.end()) {
         m_sinks.push_back(std::move(s));
     }
 }
 
 
-void Log::addDefaultLogSinks(const QString &outputDir)
+void Log::addDefaultLogSinks(const QString &outputDir, bool logToConsole)
 {
-    addLogSink(std::make_unique<ConsoleLogSink>());
+    if (logToConsole) {
+        addLogSink(std::make_unique<ConsoleLogSink>());
+    }
 
     QFileInfo fi(QDir(outputDir), "boomerang.log");
     addLogSink(std::make_unique<FileLogSink>(fi.absoluteFilePath()));
@@ -127,25 +199,28 @@ void Log::removeAllSinks()
 
 Log &Log::setLogLevel(LogLevel level)
 {
-    m_level = level;
+    m_level.store(level, std::memory_order_relaxed);
     return *this;
 }
 
 
 LogLevel Log::getLogLevel() const
 {
-    return m_level;
+    return m_level.load(std::memory_order_relaxed);
 }
 
 
 bool Log::canLog(LogLevel level) const
 {
-    return level <= m_level;
+    return level <= m_level.load(std::memory_order_relaxed);
 }
 
 
 void Log::writeLogHeader()
 {
+    // The header is written directly, so all queued messages must be written first.
+    flush();
+
     write("Level | File                                    | Line | Message\n");
     write(QString(100, '=') + "\n");
 
@@ -228,6 +303,14 @@ void Log::write(const QString &msg)
 }
 
 
+void Log::flushSinks()
+{
+    for (std::unique_ptr<ILogSink> &s : m_sinks) {
+        s->flush();
+    }
+}
+
+
 QString Log::levelToString(LogLevel level)
 {
     switch (level) {
@@ -13,16 +13,20 @@
 #include "boomerang/util/Address.h"
 #include "boomerang/util/Types.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 
+class AsyncLogWriter;
 class ILogSink;
 class Statement;
 class Exp;
 class LocationSet;
 class RTL;
 class Type;
+struct LogRecord;
 
 
 using SharedType     = std::shared_ptr<Type>;
@@ -42,6 +46,14 @@ enum class LogLevel
 };
 
 
+/// What to do with a log message in asynchronous mode if the log queue is full.
+enum class LogOverflowPolicy
+{
+    Block, ///< Wait until the log writer has made room for the message
+    Drop   ///< Discard the message. The number of dropped messages is logged later.
+};
+
+
 /**
  * Class for logging messages, warnings and errors.
  * Logs can have multiple LogSinks to enable writing to multiple targets simultaneously.
@@ -49,6 +61,13 @@ enum class LogLevel
  * Log messages have different levels (see \ref LogLevel).
  * The default behavior is to omit verbose log messages from being logged;
  * this behavior can be overridden by calling \ref setLogLevel.
+ *
+ * By default, messages are written to the log sinks immediately by the thread logging them.
+ * In asynchronous mode (see \ref setAsyncMode), messages are queued instead,
+ * and a background thread writes them to the log sinks (see \ref AsyncLogWriter).
+ * Arguments are still formatted by the logging thread, since they usually refer to
+ * IR that may change as soon as the log call returns. Logging is thread safe
+ * in asynchronous mode; log sinks must not be added or removed while other threads log.
  */
 class BOOMERANG_API Log
 {
@@ -73,7 +92,7 @@ public:
     static Log &getOrCreateLog();
 
     /**
-     * Log a message to all log sinks.
+     * Log a message to all log sinks. Thread safe.
      *
      * \param level Log level, see \ref LogLevel
      * \param file  Source file from which this function was called, usually __FILE__
@@ -104,11 +123,26 @@ public:
         log(level, file, line, collectArgs(msg, args...));
     }
 
+    /// Write all messages logged so far to the log sinks, and flush the log sinks.
     void flush();
 
+    /**
+     * Enable or disable asynchronous logging.
+     * Disabling asynchronous mode writes all queued messages before returning.
+     * \param policy What to do if more than \p capacity messages are queued.
+     * \param capacity Maximum number of queued messages; must be a power of 2.
+     */
+    void setAsyncMode(bool async, LogOverflowPolicy policy = LogOverflowPolicy::Block,
+                      std::size_t capacity = 8192);
+
+    bool isAsyncMode() const { return m_writer != nullptr; }
+
     /// Add a log sink / target. Takes ownership of the pointer.
     void addLogSink(std::unique_ptr<ILogSink> s);
-    void addDefaultLogSinks(const QString &outputDir);
+
+    /// Add the default log sinks (stdout and \p outputDir/boomerang.log).
+    /// \param logToConsole if false, only log to the log file.
+    void addDefaultLogSinks(const QString &outputDir, bool logToConsole = true);
 
     void removeAllSinks();
 
@@ -119,6 +153,12 @@ private:
     /// Check if logging is allowed with level \p level
     bool canLog(LogLevel level) const;
 
+    /// Format and write \p record to all log sinks.
+    void writeRecord(const LogRecord &record);
+
+    /// Format and write a single line message to all log sinks.
+    void writeLine(LogLevel level, const char *file, int line, const QString &msg);
+
     /// Write a header with column captions
     void writeLogHeader();
 
@@ -178,6 +218,9 @@ private:
     /// Write the raw string \p msg to all log sinks.
     void write(const QString &msg);
 
+    /// Flush all log sinks.
+    void flushSinks();
+
     /// Given a log level, get the name of the log level as a string.
     QString levelToString(LogLevel level);
 
@@ -187,8 +230,10 @@ private:
      * to have a sensible file name
      */
     size_t m_fileNameOffset;
-    LogLevel m_level = LogLevel::Default;
+    std::atomic<LogLevel> m_level;
     std::vector<std::unique_ptr<ILogSink>> m_sinks;
+    std::unique_ptr<AsyncLogWriter> m_writer; ///< Only in asynchronous mode
+    std::mutex m_writeMutex;                  ///< Serializes writes in synchronous mode
 };
 
 template<>
@@ -155,7 +155,7 @@ bool UsedLocsVisitor::visit(const std::shared_ptr<CallStatement> &stmt, bool &vi
     }
 
     if (m_countCols) {
-        for (const std::shared_ptr<Assign> &as : *stmt->getDefCollector()) {
+        for (const std::shared_ptr<Assign> &as : stmt->getDefCollector()->getDefs()) {
             as->accept(this);
         }
     }
@@ -175,7 +175,7 @@ bool UsedLocsVisitor::visit(const std::shared_ptr<ReturnStatement> &stmt, bool &
     // Also consider the reaching definitions to be uses, so when they are the only non-empty
     // component of this ReturnStatement, they can get propagated to.
     if (m_countCols) { // But we need to ignore these "uses" unless propagating
-        for (const auto &asgn : *stmt->getCollector()) {
+        for (const auto &asgn : stmt->getCollector()->getDefs()) {
             asgn->accept(this);
         }
     }
@@ -0,0 +1,113 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/frontend/MachineInstruction.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/statements/BranchStatement.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+
+#include <vector>
+
+
+BenchmarkProject::BenchmarkProject()
+{
+    getSettings()->setDataDirectory(BOOMERANG_BENCHMARK_BASE "share/boomerang/");
+    getSettings()->setPluginDirectory(BOOMERANG_BENCHMARK_BASE "lib/boomerang/plugins/");
+}
+
+
+QString getBenchmarkSamplePath(const QString &relpath)
+{
+    return QString(BOOMERANG_BENCHMARK_BASE) + "share/boomerang/samples/" + relpath;
+}
+
+
+/// Creates a fragment of type \p fragType at \p addr containing \p stmts in a single RTL.
+static IRFragment *createFragment(UserProc *proc, FragType fragType, Address addr,
+                                  const std::initializer_list<SharedStmt> &stmts)
+{
+    std::vector<MachineInstruction> insns(1);
+    insns[0].m_addr = addr;
+    insns[0].m_size = 1;
+
+    BasicBlock *bb = proc->getProg()->getCFG()->createBB(static_cast<BBType>(fragType), insns);
+    bb->setProc(proc);
+
+    std::unique_ptr<RTLList> rtls(new RTLList);
+    rtls->push_back(std::unique_ptr<RTL>(new RTL(addr, stmts)));
+
+    return proc->getCFG()->createFragment(fragType, std::move(rtls), bb);
+}
+
+
+UserProc *createDiamondChainProc(Prog *prog, Address entryAddr, int numDiamonds)
+{
+    UserProc *proc = static_cast<UserProc *>(prog->getOrCreateFunction(entryAddr));
+    ProcCFG *cfg   = proc->getCFG();
+
+    const SharedExp eax = Location::regOf(REG_X86_EAX);
+    const SharedExp ecx = Location::regOf(REG_X86_ECX);
+    const SharedExp edx = Location::regOf(REG_X86_EDX);
+
+    Address addr         = entryAddr;
+    IRFragment *prevJoin = nullptr;
+
+    for (int i = 0; i < numDiamonds; ++i) {
+        const Address joinAddr = addr + 3;
+
+        auto branch = std::make_shared<BranchStatement>(joinAddr);
+        branch->setCondType(BranchType::JNE);
+        branch->setCondExpr(Binary::get(opNotEqual, (i % 2 == 0) ? eax : ecx, Const::get(0)));
+
+        IRFragment *cond  = createFragment(proc, FragType::Twoway, addr, { branch });
+        IRFragment *left  = createFragment(proc, FragType::Oneway, addr + 1,
+                                           { std::make_shared<Assign>(eax, Const::get(i)),
+                                             std::make_shared<Assign>(ecx, edx) });
+        IRFragment *right = createFragment(proc, FragType::Oneway, addr + 2,
+                                           { std::make_shared<Assign>(ecx, Const::get(i)),
+                                             std::make_shared<Assign>(edx, eax) });
+        IRFragment *join  = createFragment(
+            proc, FragType::Oneway, joinAddr,
+            { std::make_shared<Assign>(edx, Binary::get(opPlus, ecx, eax)) });
+
+        if (prevJoin) {
+            cfg->addEdge(prevJoin, cond);
+        }
+
+        cfg->addEdge(cond, left);
+        cfg->addEdge(cond, right);
+        cfg->addEdge(left, join);
+        cfg->addEdge(right, join);
+
+        prevJoin = join;
+        addr     = joinAddr + 1;
+    }
+
+    IRFragment *ret = createFragment(proc, FragType::Ret, addr,
+                                     { std::make_shared<ReturnStatement>() });
+    if (prevJoin) {
+        cfg->addEdge(prevJoin, ret);
+    }
+
+    proc->setEntryFragment();
+    return proc;
+}
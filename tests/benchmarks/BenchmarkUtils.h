@@ -0,0 +1,41 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/Project.h"
+
+#include <QString>
+
+
+class Prog;
+class UserProc;
+
+
+/// Project using the data and plugin directories of the build tree.
+class BenchmarkProject : public Project
+{
+public:
+    BenchmarkProject();
+};
+
+
+/// \returns the full absolute path of a sample binary, given a path relative to
+/// the data/samples/ directory (e.g. "x86/fibo")
+QString getBenchmarkSamplePath(const QString &relpath);
+
+
+/**
+ * Creates a procedure at address \p entryAddr consisting of \p numDiamonds if-then-else
+ * constructs in sequence, followed by a return fragment. Each branch assigns
+ * to %eax, %ecx and %edx, and each condition uses a register defined by the previous construct,
+ * so both dominator calculation and phi placement have non-trivial work to do.
+ */
+UserProc *createDiamondChainProc(Prog *prog, Address entryAddr, int numDiamonds);
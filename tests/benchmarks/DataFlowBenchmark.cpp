@@ -0,0 +1,57 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/db/DataFlow.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+
+static void BM_CalculateDominators(benchmark::State &state)
+{
+    BenchmarkProject project;
+    Prog prog("benchmark", &project);
+    UserProc *proc = createDiamondChainProc(&prog, Address(0x1000), state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(proc->getDataFlow()->calculateDominators());
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_CalculateDominators)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
+
+
+static void BM_PlacePhiFunctions(benchmark::State &state)
+{
+    BenchmarkProject project;
+
+    for (auto _ : state) {
+        // phi functions can only be placed once per procedure, so use a new one every time
+        state.PauseTiming();
+        std::unique_ptr<Prog> prog(new Prog("benchmark", &project));
+        UserProc *proc = createDiamondChainProc(prog.get(), Address(0x1000), state.range(0));
+        proc->getDataFlow()->calculateDominators();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(proc->getDataFlow()->placePhiFunctions());
+
+        state.PauseTiming();
+        prog.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PlacePhiFunctions)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
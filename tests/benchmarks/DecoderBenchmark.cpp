@@ -0,0 +1,106 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/frontend/LiftedInstruction.h"
+#include "boomerang/frontend/MachineInstruction.h"
+#include "boomerang/ifc/IDecoder.h"
+#include "boomerang/ifc/IFrontEnd.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
+#include <benchmark/benchmark.h>
+
+
+static void BM_InstantiateRTL(benchmark::State &state, const char *insnName,
+                              const std::vector<SharedExp> &args)
+{
+    BenchmarkProject project;
+    RTLInstDict dict;
+
+    if (!dict.readSSLFile(project.getSettings()->getDataDirectory().absoluteFilePath(
+            "ssl/x86.ssl"))) {
+        state.SkipWithError("Could not read x86.ssl");
+        return;
+    }
+
+    for (auto _ : state) {
+        std::unique_ptr<RTL> rtl = dict.instantiateRTL(insnName, Address(0x1000), args);
+        benchmark::DoNotOptimize(rtl.get());
+    }
+}
+BENCHMARK_CAPTURE(BM_InstantiateRTL, MOV_reg32_reg32, "MOV.reg32.reg32",
+                  { Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_ECX) });
+BENCHMARK_CAPTURE(BM_InstantiateRTL, ADD_reg32_imm32, "ADD.reg32.imm32",
+                  { Location::regOf(REG_X86_EAX), Const::get(42) });
+BENCHMARK_CAPTURE(BM_InstantiateRTL, PUSH_reg32, "PUSH.reg32",
+                  { Location::regOf(REG_X86_EBP) });
+
+
+/// Linearly disassembles (and optionally lifts) the .text section of a sample binary.
+static void BM_DecodeTextSection(benchmark::State &state, const char *sample, bool lift)
+{
+    BenchmarkProject project;
+    project.loadPlugins();
+
+    if (!project.loadBinaryFile(getBenchmarkSamplePath(sample))) {
+        state.SkipWithError("Could not load sample binary");
+        return;
+    }
+
+    Prog *prog                = project.getProg();
+    IDecoder *decoder         = prog->getFrontEnd()->getDecoder();
+    const BinarySection *text = prog->getBinaryFile()->getImage()->getSectionByName(".text");
+
+    if (!decoder || !text) {
+        state.SkipWithError("Sample binary has no .text section");
+        return;
+    }
+
+    const Address textStart = text->getSourceAddr();
+    const Address textEnd   = textStart + text->getSize();
+    const ptrdiff_t delta   = (text->getHostAddr() - textStart).value();
+
+    int numInsns = 0;
+
+    for (auto _ : state) {
+        numInsns = 0;
+
+        for (Address pc = textStart; pc < textEnd;) {
+            MachineInstruction insn;
+            if (!decoder->disassembleInstruction(pc, delta, insn)) {
+                pc += 1; // skip invalid instruction / padding
+                continue;
+            }
+
+            if (lift) {
+                LiftedInstruction lifted;
+                benchmark::DoNotOptimize(decoder->liftInstruction(insn, lifted));
+            }
+
+            pc += insn.m_size;
+            numInsns++;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * text->getSize());
+    state.counters["instructions"] = numInsns;
+}
+BENCHMARK_CAPTURE(BM_DecodeTextSection, disassemble, "elf/hello-clang4-static", false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DecodeTextSection, disassemble_lift, "elf/hello-clang4-static", true)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,158 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/util/LocationSet.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+/// \returns \p count distinct locations as they typically occur in SSA form
+/// (stack locals, subscripted locals and register-relative memory accesses), in random order.
+static std::vector<SharedExp> createLocations(int count)
+{
+    std::vector<SharedExp> locs;
+    locs.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const SharedExp offset = Const::get(4 * (i + 1));
+        const SharedExp reg    = Location::regOf(RegNum(REG_X86_EAX + i % 8));
+
+        switch (i % 3) {
+        case 0:
+            locs.push_back(
+                Location::memOf(Binary::get(opMinus, Location::regOf(REG_X86_ESP), offset)));
+            break;
+        case 1:
+            locs.push_back(RefExp::get(
+                Location::memOf(Binary::get(opPlus, Location::regOf(REG_X86_EBP), offset)),
+                nullptr));
+            break;
+        case 2: locs.push_back(Location::memOf(Binary::get(opPlus, reg, offset))); break;
+        }
+    }
+
+    // fixed seed to get the same input for every run
+    std::shuffle(locs.begin(), locs.end(), std::mt19937(42));
+    return locs;
+}
+
+
+static void BM_ExpSimplify(benchmark::State &state)
+{
+    // m[(r28 - 4) + 8] + ((r24 * 1) + 0) - (r25 - r25) = m[r28 + 4] + r24
+    const SharedExp esp = Location::regOf(REG_X86_ESP);
+    const SharedExp eax = Location::regOf(REG_X86_EAX);
+    const SharedExp ecx = Location::regOf(REG_X86_ECX);
+
+    const SharedExp exp = Binary::get(
+        opMinus,
+        Binary::get(
+            opPlus,
+            Location::memOf(
+                Binary::get(opPlus, Binary::get(opMinus, esp, Const::get(4)), Const::get(8))),
+            Binary::get(opPlus, Binary::get(opMult, eax, Const::get(1)), Const::get(0))),
+        Binary::get(opMinus, ecx, ecx));
+
+    for (auto _ : state) {
+        SharedExp result = exp->clone()->simplify();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ExpSimplify);
+
+
+static void BM_LessExpStarSort(benchmark::State &state)
+{
+    const std::vector<SharedExp> locs = createLocations(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<SharedExp> sorted = locs;
+        std::sort(sorted.begin(), sorted.end(), lessExpStar());
+        benchmark::DoNotOptimize(sorted.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * locs.size());
+}
+BENCHMARK(BM_LessExpStarSort)->RangeMultiplier(8)->Range(8, 4096);
+
+
+static void BM_LocationSetInsert(benchmark::State &state)
+{
+    const std::vector<SharedExp> locs = createLocations(state.range(0));
+
+    for (auto _ : state) {
+        LocationSet set;
+        for (const SharedExp &loc : locs) {
+            set.insert(loc);
+        }
+
+        benchmark::DoNotOptimize(set.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * locs.size());
+}
+BENCHMARK(BM_LocationSetInsert)->RangeMultiplier(8)->Range(8, 4096);
+
+
+static void BM_LocationSetContains(benchmark::State &state)
+{
+    const std::vector<SharedExp> locs = createLocations(state.range(0));
+
+    // Only every other location is in the set, so lookups hit and miss equally often
+    LocationSet set;
+    for (std::size_t i = 0; i < locs.size(); i += 2) {
+        set.insert(locs[i]);
+    }
+
+    for (auto _ : state) {
+        int numFound = 0;
+        for (const SharedExp &loc : locs) {
+            numFound += set.contains(loc) ? 1 : 0;
+        }
+
+        benchmark::DoNotOptimize(numFound);
+    }
+
+    state.SetItemsProcessed(state.iterations() * locs.size());
+}
+BENCHMARK(BM_LocationSetContains)->RangeMultiplier(8)->Range(8, 4096);
+
+
+static void BM_LocationSetUnionDiff(benchmark::State &state)
+{
+    const std::vector<SharedExp> locs = createLocations(state.range(0));
+
+    // Two overlapping halves
+    LocationSet lhs, rhs;
+    for (std::size_t i = 0; i < locs.size(); ++i) {
+        if (i < 2 * locs.size() / 3) {
+            lhs.insert(locs[i]);
+        }
+
+        if (i >= locs.size() / 3) {
+            rhs.insert(locs[i]);
+        }
+    }
+
+    for (auto _ : state) {
+        LocationSet result = lhs;
+        result.makeUnion(rhs);
+        result.makeDiff(lhs);
+        benchmark::DoNotOptimize(result.size());
+    }
+}
+BENCHMARK(BM_LocationSetUnionDiff)->RangeMultiplier(8)->Range(8, 4096);
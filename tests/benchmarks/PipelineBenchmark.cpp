@@ -0,0 +1,88 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/core/Settings.h"
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+
+/**
+ * Runs the complete pipeline (load, decode, decompile, generate code) for a sample binary.
+ * The time spent in each phase is reported as a separate counter.
+ */
+static void BM_Pipeline(benchmark::State &state, const char *sample)
+{
+    QTemporaryDir outputDir;
+    if (!outputDir.isValid()) {
+        state.SkipWithError("Could not create output directory");
+        return;
+    }
+
+    double loadTime = 0, decodeTime = 0, decompileTime = 0, codegenTime = 0;
+    std::unique_ptr<BenchmarkProject> project;
+    QElapsedTimer timer;
+
+    for (auto _ : state) {
+        // Creating and unloading the project is not part of the pipeline
+        state.PauseTiming();
+        project.reset(new BenchmarkProject);
+        project->getSettings()->setOutputDirectory(outputDir.path());
+        project->loadPlugins();
+        state.ResumeTiming();
+
+        timer.start();
+        if (!project->loadBinaryFile(getBenchmarkSamplePath(sample))) {
+            state.SkipWithError("Could not load sample binary");
+            break;
+        }
+
+        loadTime += timer.nsecsElapsed() / 1e6;
+        timer.start();
+
+        if (!project->decodeBinaryFile()) {
+            state.SkipWithError("Could not decode sample binary");
+            break;
+        }
+
+        decodeTime += timer.nsecsElapsed() / 1e6;
+        timer.start();
+
+        if (!project->decompileBinaryFile()) {
+            state.SkipWithError("Could not decompile sample binary");
+            break;
+        }
+
+        decompileTime += timer.nsecsElapsed() / 1e6;
+        timer.start();
+
+        if (!project->generateCode()) {
+            state.SkipWithError("Could not generate code");
+            break;
+        }
+
+        codegenTime += timer.nsecsElapsed() / 1e6;
+    }
+
+    const auto avg = benchmark::Counter::kAvgIterations;
+    state.counters["load_ms"]      = benchmark::Counter(loadTime, avg);
+    state.counters["decode_ms"]    = benchmark::Counter(decodeTime, avg);
+    state.counters["decompile_ms"] = benchmark::Counter(decompileTime, avg);
+    state.counters["codegen_ms"]   = benchmark::Counter(codegenTime, avg);
+}
+BENCHMARK_CAPTURE(BM_Pipeline, hello, "x86/hello")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Pipeline, fibo_iter, "x86/fibo_iter")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Pipeline, frontier, "x86/frontier")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Pipeline, semi, "x86/semi")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,99 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <benchmark/benchmark.h>
+
+
+static void BM_StatementSweep(benchmark::State &state)
+{
+    BenchmarkProject project;
+    Prog prog("benchmark", &project);
+    UserProc *proc = createDiamondChainProc(&prog, Address(0x1000), state.range(0));
+
+    for (auto _ : state) {
+        int numStmts = 0;
+
+        for (IRFragment *frag : *proc->getCFG()) {
+            IRFragment::RTLIterator rit;
+            RTL::iterator sit;
+
+            for (SharedStmt s = frag->getFirstStmt(rit, sit); s; s = frag->getNextStmt(rit, sit)) {
+                numStmts++;
+            }
+        }
+
+        benchmark::DoNotOptimize(numStmts);
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_StatementSweep)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
+
+
+static void BM_GetStatements(benchmark::State &state)
+{
+    BenchmarkProject project;
+    Prog prog("benchmark", &project);
+    UserProc *proc = createDiamondChainProc(&prog, Address(0x1000), state.range(0));
+
+    for (auto _ : state) {
+        StatementList stmts;
+        proc->getStatements(stmts);
+        benchmark::DoNotOptimize(stmts.size());
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_GetStatements)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
+
+
+static void BM_StatementRange(benchmark::State &state)
+{
+    BenchmarkProject project;
+    Prog prog("benchmark", &project);
+    UserProc *proc = createDiamondChainProc(&prog, Address(0x1000), state.range(0));
+
+    for (auto _ : state) {
+        int numStmts = 0;
+
+        for (const SharedStmt &s : proc->getStatementRange()) {
+            benchmark::DoNotOptimize(s.get());
+            numStmts++;
+        }
+
+        benchmark::DoNotOptimize(numStmts);
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_StatementRange)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
+
+
+/// Repeated lookups of the index between two passes that do not change the IR
+static void BM_GetStatementIndex(benchmark::State &state)
+{
+    BenchmarkProject project;
+    Prog prog("benchmark", &project);
+    UserProc *proc = createDiamondChainProc(&prog, Address(0x1000), state.range(0));
+
+    for (auto _ : state) {
+        const auto stmts = proc->getStatementIndex();
+        benchmark::DoNotOptimize(stmts->size());
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_GetStatementIndex)->RangeMultiplier(4)->Range(16, 4096)->Complexity();
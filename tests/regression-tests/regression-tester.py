@@ -7,14 +7,19 @@
 # WARRANTIES.
 #
 
+import argparse
+import json
+import multiprocessing
 import os
 import shutil
 import subprocess
 import sys
 import difflib
+import time
 
 from collections import defaultdict
 from filecmp import dircmp
+from multiprocessing.pool import ThreadPool
 
 
 # These files are used for checking for regressions
@@ -349,7 +354,7 @@ def test_single_input(cli_path, input_file, output_path, expected_output_path, a
 
 
 """ Perform regression tests on inputs in test_list. Returns true on success (no regressions). """
-def perform_regression_tests(base_dir, test_input_base, test_list):
+def perform_regression_tests(cli_path, cli_args, base_dir, test_input_base, test_list):
     test_results = defaultdict();
 
     sys.stdout.write("Testing for regressions ")
@@ -359,7 +364,7 @@ def perform_regression_tests(base_dir, test_input_base, test_list):
         output_dir = os.path.join(base_dir, "outputs", test_file)
         os.makedirs(output_dir)
 
-        test_result = test_single_input(sys.argv[1], input_file, output_dir, expected_output_dir, sys.argv[2:])
+        test_result = test_single_input(cli_path, input_file, output_dir, expected_output_dir, cli_args)
         test_results[test_file] = test_result
 
         sys.stdout.write(test_result[0]) # print status
@@ -382,7 +387,7 @@ def perform_regression_tests(base_dir, test_input_base, test_list):
 
 
 """ Perform regression tests on inputs in test_list. Returns true on success (no regressions). """
-def perform_smoke_tests(base_dir, test_input_base, test_list):
+def perform_smoke_tests(cli_path, cli_args, base_dir, test_input_base, test_list):
     test_results = defaultdict();
 
     sys.stdout.write("Testing for crashes ")
@@ -393,7 +398,7 @@ def perform_smoke_tests(base_dir, test_input_base, test_list):
         output_dir = os.path.join(base_dir, "outputs", test_file)
         os.makedirs(output_dir)
 
-        test_result = test_single_input(sys.argv[1], input_file, output_dir, "", sys.argv[2:])
+        test_result = test_single_input(cli_path, input_file, output_dir, "", cli_args)
         test_results[test_file] = test_result
 
         sys.stdout.write(test_result[0]) # print status
@@ -414,7 +419,231 @@ def perform_smoke_tests(base_dir, test_input_base, test_list):
 
 
 
+""" Decompile a single input binary and collect the statistics written by --stats-out.
+    Returns the statistics, merged by phase, or None if decompilation failed. """
+def profile_single_input(cli_path, input_file, output_path, args):
+    stats_file = os.path.join(output_path, os.path.basename(input_file) + ".stats.json")
+    cmdline = [cli_path] + ['-P', os.path.dirname(cli_path), '-o', output_path, '--stats-out', stats_file] + args + [input_file]
+
+    try:
+        with open(os.path.join(output_path, os.path.basename(input_file) + ".stdout"), "w") as test_stdout, \
+             open(os.path.join(output_path, os.path.basename(input_file) + ".stderr"), "w") as test_stderr:
+
+            start_time = time.monotonic()
+            result = subprocess.call(cmdline, stdout=test_stdout, stderr=test_stderr, timeout=360)
+            wall_time = time.monotonic() - start_time
+
+        if result != 0:
+            return None
+
+        with open(stats_file, "r") as f:
+            stats = json.load(f)
+    except KeyboardInterrupt:
+        print("\nAborting performance tests at user request\n")
+        sys.exit(2)
+    except:
+        return None
+
+    # Code generation may run once per module; sum up phases with the same name.
+    # The peak RSS of the process only grows, so the peak RSS of a phase includes all previous phases.
+    phases = {}
+    for phase in stats["phases"]:
+        merged = phases.setdefault(phase["name"], { "time": 0.0, "cumulativePeakRSS": 0, "peakRSSGrowth": 0 })
+        merged["time"] += phase["time"]
+        merged["cumulativePeakRSS"] = max(merged["cumulativePeakRSS"], phase["cumulativePeakRSS"])
+        merged["peakRSSGrowth"] += phase["peakRSSGrowth"]
+
+    return { "phases": phases, "time": wall_time, "peakRSS": stats["peakRSS"] }
+
+
+
+""" Merge the statistics of two runs of the same sample by taking the minimum of each value,
+    which is the least disturbed by other processes. """
+def merge_min_stats(stats, other):
+    if stats is None or other is None:
+        return None
+
+    for name, phase in other["phases"].items():
+        if name in stats["phases"]:
+            for key in ["time", "cumulativePeakRSS", "peakRSSGrowth"]:
+                stats["phases"][name][key] = min(stats["phases"][name][key], phase[key])
+
+    stats["time"]    = min(stats["time"], other["time"])
+    stats["peakRSS"] = min(stats["peakRSS"], other["peakRSS"])
+    return stats
+
+
+
+""" Profile all inputs in test_list one after another, then all at once using num_jobs processes.
+    Returns the per-sample statistics of the serial runs, the names of failed samples
+    and the wall time of the parallel run. """
+def profile_inputs(cli_path, cli_args, base_dir, test_input_base, test_list, num_repeats, num_jobs):
+    def profile(test_file, run_name):
+        input_file = os.path.join(test_input_base, test_file)
+        output_dir = os.path.join(base_dir, "outputs-perf", run_name, test_file)
+        os.makedirs(output_dir, exist_ok=True)
+        return profile_single_input(cli_path, input_file, output_dir, cli_args)
+
+    serial_results = {}
+    sys.stdout.write("Profiling samples serially ")
+    sys.stdout.flush()
+
+    for test_file in test_list:
+        stats = profile(test_file, "serial")
+        for i in range(1, num_repeats):
+            stats = merge_min_stats(stats, profile(test_file, "serial"))
+
+        serial_results[test_file] = stats
+        sys.stdout.write('.' if stats is not None else 'f')
+        sys.stdout.flush()
+
+    print("")
+    sys.stdout.write("Profiling samples in parallel (%d jobs) ... " % num_jobs)
+    sys.stdout.flush()
+
+    start_time = time.monotonic()
+    with ThreadPool(num_jobs) as pool:
+        parallel_results = pool.starmap(profile, [(test_file, "parallel") for test_file in test_list])
+    parallel_time = time.monotonic() - start_time
+
+    print("%.2f s" % parallel_time)
+
+    failed = [test_file for test_file in test_list if serial_results[test_file] is None]
+    failed += [test_file for test_file, stats in zip(test_list, parallel_results) if stats is None and test_file not in failed]
+    return serial_results, failed, parallel_time
+
+
+
+""" Compare the statistics of the current run with the baseline.
+    A phase has regressed if it takes longer than the baseline by more than time_tolerance (relative)
+    and min_time (absolute, to ignore noise in very short phases), or if the peak memory usage of the process
+    at the end of the phase (including all previous phases) exceeds the baseline by more than memory_tolerance.
+    Returns a list of regression descriptions and the number of compared samples. """
+def compare_with_baseline(results, parallel_time, num_jobs, baseline, time_tolerance, memory_tolerance, min_time):
+    regressions = []
+    num_compared = 0
+
+    def is_time_regression(actual, expected):
+        return actual > expected * (1.0 + time_tolerance) and actual - expected > min_time
+
+    def is_memory_regression(actual, expected):
+        return actual > expected * (1.0 + memory_tolerance)
+
+    for test_file, stats in sorted(results.items()):
+        base_stats = baseline["samples"].get(test_file)
+        if stats is None or base_stats is None:
+            continue
+
+        num_compared += 1
+
+        for name, phase in sorted(stats["phases"].items()):
+            base_phase = base_stats["phases"].get(name)
+            if base_phase is None:
+                continue
+
+            if is_time_regression(phase["time"], base_phase["time"]):
+                regressions.append("%s [%s]: time %.3f s -> %.3f s (%+.0f%%)" % (test_file, name,
+                    base_phase["time"], phase["time"], 100.0 * (phase["time"] / base_phase["time"] - 1.0)))
+
+            if is_memory_regression(phase["cumulativePeakRSS"], base_phase["cumulativePeakRSS"]):
+                regressions.append("%s [%s]: cumulative peak RSS %d KiB -> %d KiB (%+.0f%%), grown by this phase: %d KiB -> %d KiB" % (
+                    test_file, name, base_phase["cumulativePeakRSS"] / 1024, phase["cumulativePeakRSS"] / 1024,
+                    100.0 * (phase["cumulativePeakRSS"] / base_phase["cumulativePeakRSS"] - 1.0),
+                    base_phase["peakRSSGrowth"] / 1024, phase["peakRSSGrowth"] / 1024))
+
+    # Parallel wall times are only comparable for the same number of jobs
+    if baseline.get("jobs") == num_jobs and baseline.get("parallelTime"):
+        if is_time_regression(parallel_time, baseline["parallelTime"]):
+            regressions.append("parallel run (%d jobs): time %.2f s -> %.2f s" % (num_jobs,
+                baseline["parallelTime"], parallel_time))
+
+    return regressions, num_compared
+
+
+
+""" Profile all samples and compare the results with the baseline.
+    Returns true on success (no failures and no performance regressions). """
+def perform_performance_tests(cli_path, cli_args, base_dir, test_input_base, test_list, options):
+    results, failed, parallel_time = profile_inputs(cli_path, cli_args, base_dir, test_input_base,
+        test_list, options.repeat, options.jobs)
+
+    if options.update_baseline:
+        baseline = {
+            "jobs": options.jobs,
+            "parallelTime": parallel_time,
+            "samples": { test_file: stats for test_file, stats in results.items() if stats is not None }
+        }
+
+        with open(options.baseline, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+        print("Baseline written to '%s'" % options.baseline)
+        return len(failed) == 0
+
+    try:
+        with open(options.baseline, "r") as f:
+            baseline = json.load(f)
+    except (IOError, ValueError):
+        print("Could not read baseline '%s'; use --update-baseline to create it." % options.baseline)
+        return False
+
+    regressions, num_compared = compare_with_baseline(results, parallel_time, options.jobs, baseline,
+        options.tolerance, options.memory_tolerance, options.min_time)
+
+    new_samples = [test_file for test_file in test_list if test_file not in baseline["samples"]]
+    if len(new_samples) != 0:
+        print("\nSamples not in baseline (not compared):")
+        for test_file in new_samples:
+            print("  " + test_file)
+
+    if len(failed) != 0:
+        print("\nFailures:")
+        for test_file in failed:
+            print("f " + test_file)
+
+    if len(regressions) != 0:
+        print("\nPerformance regressions:")
+        for regression in regressions:
+            print("  " + regression)
+
+    if num_compared == 0:
+        # An empty baseline would make every run pass
+        print("\nNo sample was compared with the baseline '%s'; use --update-baseline to create it." % options.baseline)
+
+    print("")
+    sys.stdout.flush()
+    return len(failed) == 0 and len(regressions) == 0 and num_compared > 0
+
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description="Boomerang Regression Tester")
+    parser.add_argument("--perf", action="store_true",
+        help="Compare the time and peak memory usage of each phase with a baseline instead of the output")
+    parser.add_argument("--baseline", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "perf-baseline.json"),
+        help="Baseline file for performance tests (default: perf-baseline.json next to this script)")
+    parser.add_argument("--update-baseline", action="store_true",
+        help="Write the results of the performance tests to the baseline file instead of comparing them")
+    parser.add_argument("--tolerance", type=float, default=0.25,
+        help="Maximum relative increase of the time of a phase (default: 0.25)")
+    parser.add_argument("--memory-tolerance", type=float, default=0.10,
+        help="Maximum relative increase of the peak memory usage of a phase (default: 0.10)")
+    parser.add_argument("--min-time", type=float, default=0.05,
+        help="Ignore time increases of less than this many seconds (default: 0.05)")
+    parser.add_argument("--repeat", type=int, default=1,
+        help="Profile each sample this many times serially and use the fastest run (default: 1)")
+    parser.add_argument("--jobs", type=int, default=multiprocessing.cpu_count(),
+        help="Number of samples to decompile at once for the parallel run (default: number of CPUs)")
+    parser.add_argument("cli_path", help="Path to boomerang-cli")
+    parser.add_argument("cli_args", nargs=argparse.REMAINDER, help="Additional arguments for boomerang-cli")
+    return parser.parse_args()
+
+
+
 def main():
+    options = parse_arguments()
+
     print("")
     print("Boomerang Regression Tester")
     print("===========================")
@@ -426,9 +655,16 @@ def main():
 
     all_ok = True
 
-    clean_old_outputs(base_dir)
-    all_ok &= perform_regression_tests(base_dir, tests_input_base, regression_tests)
-    all_ok &= perform_smoke_tests(base_dir, tests_input_base, smoke_tests)
+    if options.perf:
+        perf_output_dir = os.path.join(base_dir, "outputs-perf")
+        if os.path.isdir(perf_output_dir): shutil.rmtree(perf_output_dir, ignore_errors=True)
+
+        all_ok &= perform_performance_tests(options.cli_path, options.cli_args, base_dir,
+            tests_input_base, regression_tests + smoke_tests, options)
+    else:
+        clean_old_outputs(base_dir)
+        all_ok &= perform_regression_tests(options.cli_path, options.cli_args, base_dir, tests_input_base, regression_tests)
+        all_ok &= perform_smoke_tests(options.cli_path, options.cli_args, base_dir, tests_input_base, smoke_tests)
 
     print("Testing finished.\n")
 
@@ -16,7 +16,14 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+
 #include <iostream>
+#include <sstream>
 
 
 void CommandLineDriverTest::initTestCase()
@@ -351,6 +358,18 @@ void CommandLineDriverTest::testApplyCommandline()
         QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--", "test.exe" }), 0);
     }
 
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.isServerMode(), false);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--server" }), 0);
+        QCOMPARE(drv.isServerMode(), true);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--server", "test.exe" }), 1);
+    }
+
     {
         CommandlineDriver drv;
         QCOMPARE(drv.applyCommandline({ "boomerang-cli", "-E", "08", "test.exe" }), 1);
@@ -389,4 +408,59 @@ void CommandLineDriverTest::testApplyCommandline()
 }
 
 
+
+void CommandLineDriverTest::testServerJobs()
+{
+    QTemporaryDir outDir;
+    QVERIFY(outDir.isValid());
+
+    CommandlineDriver drv;
+    QCOMPARE(drv.applyCommandline({ "boomerang-cli", "-P", BOOMERANG_TEST_BASE "bin",
+                                    "-o", outDir.path(), "--server" }), 0);
+    QVERIFY(drv.isServerMode());
+
+    const QString binary = getFullSamplePath("x86/fib");
+
+    QJsonObject timeoutJob;
+    timeoutJob["id"]       = 1;
+    timeoutJob["binary"]   = binary;
+    timeoutJob["output"]   = outDir.filePath("timeout");
+    timeoutJob["timeout"]  = 0.000001;
+    timeoutJob["settings"] = QJsonObject({ { "logLevel", 5 } });
+
+    QJsonObject okJob;
+    okJob["id"]     = 2;
+    okJob["binary"] = binary;
+    okJob["output"] = outDir.filePath("ok");
+
+    QString jobs = QJsonDocument(timeoutJob).toJson(QJsonDocument::Compact) + "\n" +
+                   QJsonDocument(okJob).toJson(QJsonDocument::Compact) + "\n";
+    QTextStream jobStream(&jobs);
+    std::ostringstream resultStream;
+
+    Log::getOrCreateLog().setLogLevel(LogLevel::Default);
+    QCOMPARE(drv.serverMain(jobStream, resultStream), 0);
+
+    // the log level of the first job must not leak into the second one
+    QCOMPARE(Log::getOrCreateLog().getLogLevel(), LogLevel::Default);
+
+    std::istringstream results(resultStream.str());
+    std::string line;
+
+    QVERIFY(std::getline(results, line));
+    const QJsonObject timeoutResult = QJsonDocument::fromJson(QByteArray::fromStdString(line))
+                                          .object();
+    QCOMPARE(timeoutResult["id"].toInt(), 1);
+    QCOMPARE(timeoutResult["status"].toString(), QString("timeout"));
+
+    QVERIFY(std::getline(results, line));
+    const QJsonObject okResult = QJsonDocument::fromJson(QByteArray::fromStdString(line)).object();
+    QCOMPARE(okResult["id"].toInt(), 2);
+    QCOMPARE(okResult["status"].toString(), QString("ok"));
+    QVERIFY(QFileInfo(outDir.filePath("ok/fib/fib.c")).exists());
+
+    QVERIFY(!std::getline(results, line));
+}
+
+
 QTEST_GUILESS_MAIN(CommandLineDriverTest)
@@ -20,5 +20,8 @@ class CommandLineDriverTest : public BoomerangTest
 private slots:
     void initTestCase();
     void testApplyCommandline();
+
+    /// Test that a job whose deadline expired does not affect the next job
+    void testServerJobs();
 };
 
@@ -0,0 +1,118 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CodeBufferTest.h"
+
+
+#include "boomerang-plugins/codegen/c/CodeBuffer.h"
+
+#include <QBuffer>
+
+#include <string>
+
+
+/// \returns the contents of \p code as written to a file
+static QByteArray writeToBytes(const CodeBuffer &code)
+{
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+
+    buffer.open(QIODevice::WriteOnly);
+    const bool ok = code.writeTo(buffer);
+    buffer.close();
+
+    return ok ? bytes : QByteArray("<write error>");
+}
+
+
+void CodeBufferTest::testAppendLine()
+{
+    CodeBuffer code;
+    QVERIFY(code.isEmpty());
+    QCOMPARE(writeToBytes(code), QByteArray());
+
+    code.appendLine("int main()");
+    code.appendLine("{");
+    code.appendLine("return 0;", 1);
+    code.appendLine("", 2);
+    code.appendLine("}", -1);
+
+    QVERIFY(!code.isEmpty());
+    QCOMPARE(code.getNumLines(), std::size_t(5));
+    QCOMPARE(writeToBytes(code), QByteArray("int main()\n{\n    return 0;\n        \n}\n"));
+
+    code.clear();
+    QVERIFY(code.isEmpty());
+    QCOMPARE(writeToBytes(code), QByteArray());
+}
+
+
+void CodeBufferTest::testAppendLineNonAscii()
+{
+    CodeBuffer code;
+
+    const QString line = QString::fromUtf8("puts(\"\xC3\xA4 \xE2\x82\xAC \xF0\x9D\x84\x9E\");");
+    code.appendLine(line, 1);
+    code.appendLine("x = 1;", 1);
+
+    QCOMPARE(writeToBytes(code), QByteArray("    ") + line.toUtf8() + "\n    x = 1;\n");
+}
+
+
+void CodeBufferTest::testChunks()
+{
+    CodeBuffer code;
+    QByteArray expected;
+
+    // more than fits into a single chunk, including a line larger than a chunk
+    for (int i = 0; i < 20000; ++i) {
+        const QString line = QString("x%1 = %1;").arg(i);
+        code.appendLine(line, i % 4);
+        expected += QByteArray(4 * (i % 4), ' ') + line.toUtf8() + '\n';
+
+        if (i == 10000) {
+            const QString longLine(100000, 'y');
+            code.appendLine(longLine);
+            expected += longLine.toUtf8() + '\n';
+        }
+    }
+
+    QCOMPARE(code.getNumLines(), std::size_t(20001));
+    QVERIFY(writeToBytes(code) == expected);
+}
+
+
+void CodeBufferTest::testRemoveLines()
+{
+    CodeBuffer code;
+    QByteArray expected;
+
+    for (int i = 0; i < 20000; ++i) {
+        const QString line = QString("bb%1:").arg(i);
+        code.appendLine(line);
+
+        if (i % 3 != 0) {
+            expected += line.toUtf8() + '\n';
+        }
+    }
+
+    code.removeLines([](std::string_view line) {
+        return std::stoi(std::string(line.substr(2))) % 3 == 0;
+    });
+
+    QCOMPARE(code.getNumLines(), std::size_t(13333));
+    QVERIFY(writeToBytes(code) == expected);
+
+    // Removing nothing does not change anything
+    code.removeLines([](std::string_view) { return false; });
+    QVERIFY(writeToBytes(code) == expected);
+}
+
+
+QTEST_GUILESS_MAIN(CodeBufferTest)
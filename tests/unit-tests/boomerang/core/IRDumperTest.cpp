@@ -0,0 +1,98 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IRDumperTest.h"
+
+
+#include "boomerang/core/IRDumper.h"
+
+
+Q_DECLARE_METATYPE(std::vector<QString>)
+
+
+void IRDumperTest::testFilters()
+{
+    IRDumper dumper;
+    QVERIFY(!dumper.isEnabled());
+
+    QVERIFY(!dumper.setPassFilter("Statement("));
+    QVERIFY(dumper.setPassFilter("Statement.*"));
+    QVERIFY(!dumper.isEnabled());
+
+    QVERIFY(!dumper.setProcFilter("main|("));
+    QVERIFY(!dumper.isEnabled());
+
+    QVERIFY(dumper.setProcFilter("main|proc_.*"));
+    QVERIFY(dumper.isEnabled());
+
+    dumper.disable();
+    QVERIFY(!dumper.isEnabled());
+}
+
+
+void IRDumperTest::testDiff()
+{
+    QFETCH(std::vector<QString>, from);
+    QFETCH(std::vector<QString>, to);
+    QFETCH(int, numEdits);
+
+    const std::vector<IRDumper::Edit> edits = IRDumper::diff(from, to);
+    QCOMPARE(static_cast<int>(edits.size()), numEdits);
+
+    // Applying the edits to 'from' must result in 'to'
+    std::vector<QString> result;
+    std::size_t fromIdx = 0;
+
+    for (const IRDumper::Edit &edit : edits) {
+        if (edit.isInsert) {
+            while (result.size() < edit.index) {
+                result.push_back(from[fromIdx++]);
+            }
+
+            result.push_back(to[edit.index]);
+        }
+        else {
+            while (fromIdx < edit.index) {
+                result.push_back(from[fromIdx++]);
+            }
+
+            fromIdx = edit.index + 1;
+        }
+    }
+
+    while (fromIdx < from.size()) {
+        result.push_back(from[fromIdx++]);
+    }
+
+    QVERIFY(result == to);
+}
+
+
+void IRDumperTest::testDiff_data()
+{
+    QTest::addColumn<std::vector<QString>>("from");
+    QTest::addColumn<std::vector<QString>>("to");
+    QTest::addColumn<int>("numEdits");
+
+    const std::vector<QString> abc = { "a", "b", "c" };
+
+    QTest::newRow("empty") << std::vector<QString>{} << std::vector<QString>{} << 0;
+    QTest::newRow("equal") << abc << abc << 0;
+    QTest::newRow("insert all") << std::vector<QString>{} << abc << 3;
+    QTest::newRow("delete all") << abc << std::vector<QString>{} << 3;
+    QTest::newRow("replace middle") << abc << std::vector<QString>{ "a", "x", "c" } << 2;
+    QTest::newRow("insert front") << abc << std::vector<QString>{ "x", "a", "b", "c" } << 1;
+    QTest::newRow("delete back") << abc << std::vector<QString>{ "a", "b" } << 1;
+    QTest::newRow("move") << abc << std::vector<QString>{ "b", "c", "a" } << 2;
+    QTest::newRow("mixed") << std::vector<QString>{ "a", "b", "c", "a", "b", "b", "a" }
+                           << std::vector<QString>{ "c", "b", "a", "b", "a", "c" } << 5;
+}
+
+
+QTEST_GUILESS_MAIN(IRDumperTest)
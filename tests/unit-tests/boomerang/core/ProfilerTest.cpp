@@ -0,0 +1,204 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProfilerTest.h"
+
+#include "boomerang/core/Profiler.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+
+static QJsonObject readJSON(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly)) {
+        return QJsonObject();
+    }
+
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+
+void ProfilerTest::testDisabled()
+{
+    Profiler profiler;
+    QVERIFY(!profiler.isEnabled());
+
+    {
+        ProfileScope scope(&profiler, ProfileCategory::Phase, "decode");
+        profiler.addToCounter("decodedInstructions");
+    }
+
+    QVERIFY(profiler.getScopes().empty());
+    QVERIFY(profiler.getCounters().empty());
+
+    // no profiler at all
+    ProfileScope scope(nullptr, ProfileCategory::Pass, "none");
+}
+
+
+void ProfilerTest::testScopes()
+{
+    Profiler profiler;
+    profiler.setEnabled(true);
+
+    {
+        ProfileScope phase(&profiler, ProfileCategory::Phase, "decompile");
+        {
+            ProfileScope pass1(&profiler, ProfileCategory::Pass, QString("Dominators"));
+        }
+        {
+            ProfileScope pass2(&profiler, ProfileCategory::Pass, QString("PhiPlacement"));
+        }
+    }
+
+    const std::vector<Profiler::Scope> &scopes = profiler.getScopes();
+    QCOMPARE(scopes.size(), std::size_t(3));
+
+    QCOMPARE(scopes[0].name, QString("decompile"));
+    QCOMPARE(scopes[0].depth, 0);
+    QVERIFY(scopes[0].category == ProfileCategory::Phase);
+
+    QCOMPARE(scopes[1].name, QString("Dominators"));
+    QCOMPARE(scopes[1].depth, 1);
+    QVERIFY(scopes[1].category == ProfileCategory::Pass);
+    QCOMPARE(scopes[2].name, QString("PhiPlacement"));
+    QCOMPARE(scopes[2].depth, 1);
+
+    // children are nested in their parent
+    QVERIFY(scopes[1].start >= scopes[0].start);
+    QVERIFY(scopes[2].start >= scopes[1].start + scopes[1].duration);
+    QVERIFY(scopes[2].start + scopes[2].duration <= scopes[0].start + scopes[0].duration);
+
+    // re-enabling discards old data
+    profiler.setEnabled(false);
+    profiler.setEnabled(true);
+    QVERIFY(profiler.getScopes().empty());
+}
+
+
+void ProfilerTest::testAddScope()
+{
+    Profiler profiler;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto end   = start + std::chrono::milliseconds(5);
+
+    // ignored while disabled
+    profiler.addScope(ProfileCategory::Proc, "generateCode", nullptr, start, end);
+    QVERIFY(profiler.getScopes().empty());
+
+    profiler.setEnabled(true);
+    {
+        ProfileScope phase(&profiler, ProfileCategory::Phase, "codegen");
+        const auto jobStart = std::chrono::steady_clock::now();
+        profiler.addScope(ProfileCategory::Proc, "generateCode", nullptr, jobStart,
+                          jobStart + std::chrono::milliseconds(5));
+    }
+
+    const std::vector<Profiler::Scope> &scopes = profiler.getScopes();
+    QCOMPARE(scopes.size(), std::size_t(2));
+
+    QCOMPARE(scopes[1].name, QString("generateCode"));
+    QCOMPARE(scopes[1].depth, 1);
+    QVERIFY(scopes[1].category == ProfileCategory::Proc);
+    QVERIFY(scopes[1].start >= scopes[0].start);
+    QVERIFY(scopes[1].duration == std::chrono::milliseconds(5));
+}
+
+
+void ProfilerTest::testCounters()
+{
+    Profiler profiler;
+    profiler.setEnabled(true);
+
+    profiler.addToCounter("decodedInstructions");
+    profiler.addToCounter("decodedInstructions", 41);
+    profiler.addToCounter("badDecodes");
+
+    QCOMPARE(profiler.getCounters().size(), std::size_t(2));
+    QCOMPARE(profiler.getCounters().at("decodedInstructions"), sint64(42));
+    QCOMPARE(profiler.getCounters().at("badDecodes"), sint64(1));
+
+    profiler.clear();
+    QVERIFY(profiler.getCounters().empty());
+}
+
+
+void ProfilerTest::testWriteJSON()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    Profiler profiler;
+    profiler.setEnabled(true);
+
+    {
+        ProfileScope phase(&profiler, ProfileCategory::Phase, "decompile");
+        ProfileScope pass1(&profiler, ProfileCategory::Pass, QString("Dominators"));
+        ProfileScope pass2(&profiler, ProfileCategory::Pass, QString("Dominators"));
+    }
+
+    profiler.addToCounter("decompiledProcs", 3);
+
+    const QString filePath = dir.filePath("profile.json");
+    QVERIFY(profiler.writeJSON(filePath));
+
+    const QJsonObject root = readJSON(filePath);
+    QCOMPARE(root["scopes"].toArray().size(), 3);
+    QCOMPARE(root["scopes"].toArray()[0].toObject()["name"].toString(), QString("decompile"));
+    QCOMPARE(root["scopes"].toArray()[0].toObject()["category"].toString(), QString("phase"));
+
+    const QJsonObject passes = root["summary"].toObject()["pass"].toObject();
+    QCOMPARE(passes["Dominators"].toObject()["count"].toInt(), 2);
+    QCOMPARE(root["counters"].toObject()["decompiledProcs"].toInt(), 3);
+}
+
+
+void ProfilerTest::testWriteChromeTrace()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    Profiler profiler;
+    profiler.setEnabled(true);
+
+    {
+        ProfileScope phase(&profiler, ProfileCategory::Phase, "decode");
+        ProfileScope pass(&profiler, ProfileCategory::Pass, QString("StatementInit"));
+    }
+
+    const QString filePath = dir.filePath("trace.json");
+    QVERIFY(profiler.writeChromeTrace(filePath));
+
+    const QJsonArray events = readJSON(filePath)["traceEvents"].toArray();
+
+    int numCompleteEvents = 0;
+    for (const QJsonValue &event : events) {
+        const QJsonObject obj = event.toObject();
+        if (obj["ph"].toString() == "X") {
+            numCompleteEvents++;
+            QVERIFY(obj.contains("ts"));
+            QVERIFY(obj.contains("dur"));
+        }
+        else {
+            // memory samples for phases
+            QCOMPARE(obj["ph"].toString(), QString("C"));
+        }
+    }
+
+    QCOMPARE(numCompleteEvents, 2);
+}
+
+
+QTEST_GUILESS_MAIN(ProfilerTest)
@@ -13,6 +13,7 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
 
 
 void ProjectTest::testLoadBinaryFile()
@@ -104,6 +105,77 @@ void ProjectTest::testDecompileBinaryFile()
 }
 
 
+void ProjectTest::testDecompileProc()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->decodeOnDemand = true;
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+
+    Function *main = project.getProg()->getFunctionByName("main");
+    QVERIFY(main != nullptr && !main->isLib());
+
+    QVERIFY(project.decompileProc(static_cast<UserProc *>(main)));
+    QVERIFY(static_cast<UserProc *>(main)->isDecompiled());
+    QVERIFY(project.decompileProc(static_cast<UserProc *>(main))); // cached
+
+    QVERIFY(project.generateCode());
+}
+
+
+void ProjectTest::testDecompileWithBudget()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->procPassBudget = 1;
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+
+    Function *main = project.getProg()->getFunctionByName("main");
+    QVERIFY(main != nullptr && !main->isLib());
+    QVERIFY(static_cast<UserProc *>(main)->isDegraded());
+    QVERIFY(static_cast<UserProc *>(main)->isDecompiled());
+
+    QVERIFY(project.generateCode());
+}
+
+
+void ProjectTest::testDecodeWithRoots()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->m_rootProcs.push_back("fib");
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("x86/fib")));
+    QVERIFY(project.decodeBinaryFile());
+
+    // main calls fib, but not vice versa
+    Function *fib = project.getProg()->getFunctionByName("fib");
+    QVERIFY(fib != nullptr && !fib->isLib());
+    QVERIFY(project.getProg()->getFunctionByName("main") == nullptr);
+
+    QCOMPARE(project.getProg()->getEntryProcs().size(), std::size_t(1));
+    QCOMPARE(project.getProg()->getEntryProcs().front(), static_cast<UserProc *>(fib));
+
+    QVERIFY(project.decompileBinaryFile());
+    QVERIFY(static_cast<UserProc *>(fib)->isDecompiled());
+
+    project.getSettings()->m_rootProcs = { "no_such_proc" };
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("x86/fib")));
+    QVERIFY(!project.decodeBinaryFile());
+}
+
+
 void ProjectTest::testGenerateCode()
 {
     Project project;
@@ -122,4 +194,41 @@ void ProjectTest::testGenerateCode()
 }
 
 
+void ProjectTest::testPhaseStats()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QVERIFY(project.getPhaseStats().empty());
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+    QVERIFY(project.generateCode());
+
+    const std::vector<PhaseStats> &stats = project.getPhaseStats();
+    QCOMPARE(stats.size(), std::size_t(4));
+    QCOMPARE(stats[0].name, QString("load"));
+    QCOMPARE(stats[1].name, QString("decode"));
+    QCOMPARE(stats[2].name, QString("decompile"));
+    QCOMPARE(stats[3].name, QString("codegen"));
+
+    for (const PhaseStats &phase : stats) {
+        QVERIFY(phase.time.count() >= 0);
+        QVERIFY(phase.peakMemoryGrowth <= phase.peakMemoryUsage);
+    }
+
+    // the peak memory usage is cumulative
+    for (std::size_t i = 1; i < stats.size(); ++i) {
+        QVERIFY(stats[i].peakMemoryUsage >= stats[i - 1].peakMemoryUsage);
+    }
+
+    // loading a new binary starts from scratch
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QCOMPARE(project.getPhaseStats().size(), std::size_t(1));
+}
+
+
 QTEST_GUILESS_MAIN(ProjectTest)
@@ -33,5 +33,10 @@ private slots:
 
     void testDecodeBinaryFile();
     void testDecompileBinaryFile();
+    void testDecompileProc();
+    void testDecompileWithBudget();
+    void testDecodeWithRoots();
     void testGenerateCode();
+
+    void testPhaseStats();
 };
@@ -270,6 +270,64 @@ void DataFlowTest::testPlacePhi2()
 }
 
 
+void DataFlowTest::testPlacePhiPruned()
+{
+    m_project.getSettings()->usePrunedSSA = true;
+
+    Prog prog("test", &m_project);
+    UserProc *proc = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1000)));
+
+    ProcCFG *cfg = proc->getCFG();
+    DataFlow *df = proc->getDataFlow();
+
+    IRFragment *join = nullptr;
+
+    // set up:
+    // if (edx != 0) { eax = 1; ecx = 1; } else { eax = 2; ecx = 2; } ecx = 3; return;
+    {
+        IRFragment *entry = createBBAndFragment(prog.getCFG(), BBType::Twoway, Address(0x1000), proc);
+        IRFragment *left  = createBBAndFragment(prog.getCFG(), BBType::Oneway, Address(0x1001), proc);
+        IRFragment *right = createBBAndFragment(prog.getCFG(), BBType::Oneway, Address(0x1002), proc);
+        join              = createBBAndFragment(prog.getCFG(), BBType::Ret,    Address(0x1003), proc);
+
+        cfg->addEdge(entry, left);
+        cfg->addEdge(entry, right);
+        cfg->addEdge(left, join);
+        cfg->addEdge(right, join);
+
+        proc->setEntryFragment();
+
+        auto branch = std::make_shared<BranchStatement>(Address(0x1000));
+        branch->setCondType(BranchType::JNE);
+        branch->setCondExpr(Binary::get(opNotEqual, Location::regOf(REG_X86_EDX), Const::get(0)));
+
+        entry->getRTLs()->front()->clear();
+        entry->getRTLs()->front()->append(branch);
+
+        left->getRTLs()->front()->clear();
+        left->getRTLs()->front()->append(std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Const::get(1)));
+        left->getRTLs()->front()->append(std::make_shared<Assign>(Location::regOf(REG_X86_ECX), Const::get(1)));
+
+        right->getRTLs()->front()->clear();
+        right->getRTLs()->front()->append(std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Const::get(2)));
+        right->getRTLs()->front()->append(std::make_shared<Assign>(Location::regOf(REG_X86_ECX), Const::get(2)));
+
+        join->getRTLs()->front()->clear();
+        join->getRTLs()->front()->append(std::make_shared<Assign>(Location::regOf(REG_X86_ECX), Const::get(3)));
+        join->getRTLs()->front()->append(std::make_shared<ReturnStatement>());
+    }
+
+    QVERIFY(df->calculateDominators());
+    QVERIFY(df->placePhiFunctions());
+
+    // eax reaches the return, but ecx is redefined before
+    QCOMPARE(df->getA_phi(Location::regOf(REG_X86_EAX)), std::set<FragIndex>({ df->fragToIdx(join) }));
+    QCOMPARE(df->getA_phi(Location::regOf(REG_X86_ECX)), std::set<FragIndex>({}));
+
+    m_project.getSettings()->usePrunedSSA = false;
+}
+
+
 void DataFlowTest::testRenameVars()
 {
     QVERIFY(m_project.loadBinaryFile(FRONTIER_X86));
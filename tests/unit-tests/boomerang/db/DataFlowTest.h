@@ -33,6 +33,9 @@ private slots:
     /// Test a case where a phi function is not needed
     void testPlacePhi2();
 
+    /// Test that no phi functions are placed for dead locations
+    void testPlacePhiPruned();
+
     /// Test the renaming of variables
     void testRenameVars();
     void testRenameVarsSelfLoop();
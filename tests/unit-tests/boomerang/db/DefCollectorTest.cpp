@@ -0,0 +1,128 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DefCollectorTest.h"
+
+
+#include "boomerang/db/DefCollector.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+
+void DefCollectorTest::testMakeCloneOf()
+{
+    DefCollector col1;
+    col1.collectDef(std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_ECX)));
+
+    DefCollector col2;
+    col2.makeCloneOf(col1);
+    QVERIFY(col2.isSharedWith(col1));
+    QVERIFY(col2.hasDefOf(Location::regOf(REG_X86_EAX)));
+
+    // modifying one of the collectors un-shares them
+    col2.collectDef(std::make_shared<Assign>(Location::regOf(REG_X86_EDX), Location::regOf(REG_X86_ECX)));
+    QVERIFY(!col2.isSharedWith(col1));
+    QVERIFY(col2.hasDefOf(Location::regOf(REG_X86_EDX)));
+    QVERIFY(!col1.hasDefOf(Location::regOf(REG_X86_EDX)));
+
+    // empty collectors do not share anything
+    DefCollector col3;
+    col1.makeCloneOf(col3);
+    QVERIFY(!col1.isSharedWith(col3));
+    QVERIFY(!col1.hasDefOf(Location::regOf(REG_X86_EAX)));
+    QCOMPARE(col1.getDefs().size(), 0);
+}
+
+
+void DefCollectorTest::testCollect()
+{
+    DefCollector col;
+    QVERIFY(!col.hasDefOf(Location::regOf(REG_X86_EAX)));
+    QVERIFY(col.findDefFor(Location::regOf(REG_X86_EAX)) == nullptr);
+
+    // iterating an empty collector does not allocate any definitions
+    QVERIFY(col.begin() == col.end());
+    QVERIFY(!col.isSharedWith(col));
+
+    col.collectDef(std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_ECX)));
+    QVERIFY(col.hasDefOf(Location::regOf(REG_X86_EAX)));
+    QVERIFY(*col.findDefFor(Location::regOf(REG_X86_EAX)) == *Location::regOf(REG_X86_ECX));
+
+    // already collected
+    col.collectDef(std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_EDX)));
+    QVERIFY(*col.findDefFor(Location::regOf(REG_X86_EAX)) == *Location::regOf(REG_X86_ECX));
+
+    col.clear();
+    QVERIFY(!col.hasDefOf(Location::regOf(REG_X86_EAX)));
+}
+
+
+void DefCollectorTest::testSearchReplaceAll()
+{
+    DefCollector col1;
+    col1.collectDef(std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_ECX)));
+
+    DefCollector col2;
+    col2.makeCloneOf(col1);
+
+    bool changed = false;
+    col2.searchReplaceAll(*Location::regOf(REG_X86_ECX), Const::get(0), changed);
+    QVERIFY(changed);
+
+    // the definitions of col1 must not change
+    QVERIFY(*col2.findDefFor(Location::regOf(REG_X86_EAX)) == *Const::get(0));
+    QVERIFY(*col1.findDefFor(Location::regOf(REG_X86_EAX)) == *Location::regOf(REG_X86_ECX));
+}
+
+
+void DefCollectorTest::testUpdateDefs()
+{
+    std::shared_ptr<Assign> def(new Assign(Location::regOf(REG_X86_EAX), Const::get(0)));
+
+    std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> stacks;
+    stacks[Location::regOf(REG_X86_EAX)].push(def);
+    stacks[Location::regOf(REG_X86_ECX)]; // does not reach
+
+    DefCollector col1;
+    col1.updateDefs(stacks, nullptr);
+    QCOMPARE(col1.getDefs().size(), 1);
+    QVERIFY(*col1.findDefFor(Location::regOf(REG_X86_EAX)) == *RefExp::get(Location::regOf(REG_X86_EAX), def));
+
+    // Nothing new reaches; the definitions stay shared
+    DefCollector col2;
+    col2.makeCloneOf(col1);
+    col2.updateDefs(stacks, nullptr);
+    QVERIFY(col2.isSharedWith(col1));
+
+    stacks[Location::regOf(REG_X86_ECX)].push(def);
+    col2.updateDefs(stacks, nullptr);
+    QVERIFY(!col2.isSharedWith(col1));
+    QCOMPARE(col1.getDefs().size(), 1);
+    QCOMPARE(col2.getDefs().size(), 2);
+
+    // collectors reached by the same definitions share them via the pool
+    DefCollectorPool pool;
+    DefCollector col3, col4;
+    col3.updateDefs(stacks, nullptr, &pool);
+    col4.updateDefs(stacks, nullptr, &pool);
+    QVERIFY(col4.isSharedWith(col3));
+    QCOMPARE(col4.getDefs().size(), 2);
+
+    // different definitions are not shared
+    stacks[Location::regOf(REG_X86_EDX)].push(def);
+    col4.updateDefs(stacks, nullptr, &pool);
+    QVERIFY(!col4.isSharedWith(col3));
+    QCOMPARE(col3.getDefs().size(), 2);
+    QCOMPARE(col4.getDefs().size(), 3);
+}
+
+
+QTEST_GUILESS_MAIN(DefCollectorTest)
@@ -93,8 +93,8 @@ void IRFragmentTest::testGetStmt()
 
     IRFragment::RTLIterator rit;
     IRFragment::RTLRIterator rrit;
-    StatementList::iterator sit;
-    StatementList::reverse_iterator srit;
+    RTL::iterator sit;
+    RTL::reverse_iterator srit;
 
     {
         IRFragment bb1(1, nullptr, Address(0x1000));
@@ -0,0 +1,101 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "UseCollectorTest.h"
+
+
+#include "boomerang/db/UseCollector.h"
+#include "boomerang/ssl/exp/Location.h"
+
+
+void UseCollectorTest::testMakeCloneOf()
+{
+    UseCollector col1;
+    col1.collectUse(Location::regOf(REG_X86_EAX));
+
+    UseCollector col2;
+    col2.makeCloneOf(col1);
+    QVERIFY(col2.isSharedWith(col1));
+    QVERIFY(col2 == col1);
+
+    // modifying one of the collectors un-shares them
+    col2.collectUse(Location::regOf(REG_X86_ECX));
+    QVERIFY(!col2.isSharedWith(col1));
+    QVERIFY(col2.hasUse(Location::regOf(REG_X86_ECX)));
+    QVERIFY(!col1.hasUse(Location::regOf(REG_X86_ECX)));
+
+    // empty collectors do not share anything
+    UseCollector col3;
+    col1.makeCloneOf(col3);
+    QVERIFY(!col1.isSharedWith(col3));
+    QVERIFY(col1.getUses().empty());
+}
+
+
+void UseCollectorTest::testCollect()
+{
+    UseCollector col;
+    QVERIFY(!col.hasUse(Location::regOf(REG_X86_EAX)));
+
+    // iterating an empty collector does not allocate any locations
+    QVERIFY(col.begin() == col.end());
+    QVERIFY(!col.isSharedWith(col));
+
+    col.collectUse(Location::regOf(REG_X86_EAX));
+    col.collectUse(Location::regOf(REG_X86_EAX));
+    QVERIFY(col.hasUse(Location::regOf(REG_X86_EAX)));
+    QCOMPARE(col.getUses().size(), 1);
+
+    col.clear();
+    QVERIFY(!col.hasUse(Location::regOf(REG_X86_EAX)));
+}
+
+
+void UseCollectorTest::testRemoveUse()
+{
+    UseCollector col1;
+    col1.collectUse(Location::regOf(REG_X86_EAX));
+    col1.collectUse(Location::regOf(REG_X86_ECX));
+
+    UseCollector col2;
+    col2.makeCloneOf(col1);
+
+    // removing a location that is not collected does not un-share the collectors
+    col2.removeUse(Location::regOf(REG_X86_EDX));
+    QVERIFY(col2.isSharedWith(col1));
+
+    col2.removeUse(Location::regOf(REG_X86_EAX));
+    QVERIFY(!col2.hasUse(Location::regOf(REG_X86_EAX)));
+    QVERIFY(col1.hasUse(Location::regOf(REG_X86_EAX)));
+
+    UseCollector::iterator it = col2.begin();
+    it = col2.removeUse(it);
+    QVERIFY(it == col2.end());
+    QVERIFY(col2.getUses().empty());
+    QCOMPARE(col1.getUses().size(), 2);
+}
+
+
+void UseCollectorTest::testEquals()
+{
+    UseCollector col1, col2;
+    QVERIFY(col1 == col2);
+
+    col1.collectUse(Location::regOf(REG_X86_EAX));
+    QVERIFY(col1 != col2);
+
+    col2.collectUse(Location::regOf(REG_X86_EAX));
+    QVERIFY(col1 == col2);
+
+    col2.collectUse(Location::regOf(REG_X86_ECX));
+    QVERIFY(col1 != col2);
+}
+
+
+QTEST_GUILESS_MAIN(UseCollectorTest)
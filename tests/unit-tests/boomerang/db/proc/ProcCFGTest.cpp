@@ -185,6 +185,25 @@ void ProcCFGTest::testRemoveFragment()
 }
 
 
+void ProcCFGTest::testClear()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Fall, createInsns(Address(0x1000), 1));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+    bb1->setProc(&proc);
+
+    cfg->createFragment(FragType::Fall, createRTLs(Address(0x1000), 1, 1), bb1);
+    QCOMPARE(proc.getStatementIndex()->size(), std::size_t(1));
+
+    // the statement index must not keep the deleted statements alive
+    cfg->clear();
+    QCOMPARE(cfg->getNumFragments(), 0);
+    QVERIFY(proc.getStatementIndex()->empty());
+}
+
+
 void ProcCFGTest::testGetFragmentByAddr()
 {
     QSKIP("Not implemented");
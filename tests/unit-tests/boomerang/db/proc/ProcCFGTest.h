@@ -26,6 +26,7 @@ private slots:
     void testSplitFragment();
     void testEntryAndExitFragment();
     void testRemoveFragment();
+    void testClear();
     void testGetFragmentByAddr();
     void testAddEdge();
     void testIsWellFormed();
@@ -259,6 +259,94 @@ void UserProcTest::testReplacePhiByAssign()
 }
 
 
+void UserProcTest::testGetStatementRange()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Oneway, createInsns(Address(0x1000), 1));
+    BasicBlock *bb2 = prog.getCFG()->createBB(BBType::Oneway, createInsns(Address(0x1001), 1));
+    BasicBlock *bb3 = prog.getCFG()->createBB(BBType::Fall, createInsns(Address(0x1002), 1));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    QVERIFY(proc.getStatementRange().empty());
+    QVERIFY(proc.getStatementRange().begin() == proc.getStatementRange().end());
+
+    proc.getCFG()->createFragment(FragType::Oneway, createRTLs(Address(0x1000), 2, 2), bb1);
+    proc.getCFG()->createFragment(FragType::Oneway, createRTLs(Address(0x1001), 3, 0), bb2);
+    proc.getCFG()->createFragment(FragType::Fall, createRTLs(Address(0x1002), 1, 1), bb3);
+    proc.setEntryFragment();
+
+    StatementList stmts;
+    proc.getStatements(stmts);
+    QCOMPARE(stmts.size(), static_cast<std::size_t>(5));
+
+    // empty fragments and RTLs are skipped
+    QVERIFY(!proc.getStatementRange().empty());
+    QVERIFY(std::equal(stmts.begin(), stmts.end(), proc.getStatementRange().begin(),
+                       proc.getStatementRange().end()));
+}
+
+
+void UserProcTest::testGetStatementIndex()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Fall, createInsns(Address(0x1000), 1));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    QVERIFY(proc.getStatementIndex()->empty());
+
+    // adding a fragment invalidates the index
+    IRFragment *frag = proc.getCFG()->createFragment(FragType::Fall, createRTLs(Address(0x1000), 2, 1), bb1);
+    proc.setEntryFragment();
+
+    const auto index = proc.getStatementIndex();
+    QCOMPARE(index->size(), static_cast<std::size_t>(2));
+    QVERIFY(proc.getStatementIndex() == index);
+
+    for (const SharedStmt &s : *index) {
+        QVERIFY(s->getProc() == &proc);
+        s->setFragment(frag);
+    }
+
+    // removing a statement invalidates the index, but not the copy that is kept alive
+    QVERIFY(proc.removeStatement(index->front()));
+    QCOMPARE(index->size(), static_cast<std::size_t>(2));
+    QVERIFY(proc.getStatementIndex() != index);
+    QCOMPARE(proc.getStatementIndex()->size(), static_cast<std::size_t>(1));
+    QVERIFY(proc.getStatementIndex()->front() == index->back());
+}
+
+
+void UserProcTest::testNumberStatements()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Fall, createInsns(Address(0x1000), 1));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    IRFragment *frag = proc.getCFG()->createFragment(FragType::Fall, createRTLs(Address(0x1000), 2, 1), bb1);
+    proc.setEntryFragment();
+
+    const auto stmts = proc.getStatementIndex();
+    QCOMPARE(stmts->front()->getNumber(), 0);
+
+    proc.numberStatements();
+    QCOMPARE(stmts->front()->getNumber(), 1);
+    QCOMPARE(stmts->back()->getNumber(), 2);
+
+    // reading the numbers does not renumber the statements
+    stmts->front()->setFragment(frag);
+    std::shared_ptr<Assign> as = proc.insertAssignAfter(stmts->front(), Location::regOf(REG_X86_EAX),
+                                                        Location::regOf(REG_X86_ECX));
+    QVERIFY(as != nullptr);
+    QCOMPARE(as->getNumber(), 0);
+    QCOMPARE(stmts->back()->getNumber(), 2);
+
+    proc.numberStatements();
+    QCOMPARE(as->getNumber(), 2);
+    QCOMPARE(stmts->back()->getNumber(), 3);
+    QCOMPARE(as->toString(), "   2 *v* r24 := r25");
+}
+
+
 void UserProcTest::testAddParameterToSignature()
 {
     UserProc proc(Address(0x1000), "test", nullptr);
@@ -826,6 +914,37 @@ void UserProcTest::testPreservesExpWithOffset()
 }
 
 
+void UserProcTest::testProofCacheInvalidation()
+{
+    Prog prog("test", &m_project);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Ret, createInsns(Address(0x1000), 1));
+
+    UserProc proc(Address(0x1000), "test", prog.getRootModule());
+
+    SharedExp eax = Location::regOf(REG_X86_EAX);
+
+    // s1: eax := 5
+    std::shared_ptr<Assign> asgn(new Assign(VoidType::get(), eax->clone(), Const::get(5)));
+    std::unique_ptr<RTLList> bbRTLs(new RTLList);
+    bbRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { asgn })));
+    IRFragment *frag = proc.getCFG()->createFragment(FragType::Ret, std::move(bbRTLs), bb1);
+    asgn->setFragment(frag);
+    asgn->setProc(&proc);
+
+    // eax{s1} reaches the exit
+    std::shared_ptr<ReturnStatement> retStmt(new ReturnStatement);
+    retStmt->getCollector()->collectDef(
+        std::make_shared<Assign>(eax->clone(), RefExp::get(eax->clone(), asgn)));
+    proc.setRetStmt(retStmt, Address(0x1000));
+
+    QVERIFY(!proc.preservesExp(eax));
+
+    // s1: eax := eax{-}; the cached failure must not be reused
+    QVERIFY(proc.searchAndReplace(*Const::get(5), RefExp::get(eax->clone(), nullptr)));
+    QVERIFY(proc.preservesExp(eax));
+}
+
+
 void UserProcTest::testPromoteSignature()
 {
     QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/fib")));
@@ -23,6 +23,9 @@ private slots:
     void testInsertAssignAfter();
     void testInsertStatementAfter();
     void testReplacePhiByAssign();
+    void testGetStatementRange();
+    void testGetStatementIndex();
+    void testNumberStatements();
 
     void testAddParameterToSignature();
     void testInsertParameter();
@@ -51,6 +54,7 @@ private slots:
     void testAddCallee();
     void testPreservesExp();
     void testPreservesExpWithOffset();
+    void testProofCacheInvalidation();
     void testPromoteSignature();
     void testFindFirstSymbol();
     void testSearchAndReplace();
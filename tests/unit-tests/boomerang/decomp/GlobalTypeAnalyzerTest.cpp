@@ -0,0 +1,62 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "GlobalTypeAnalyzerTest.h"
+
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/GlobalTypeAnalyzer.h"
+#include "boomerang/ssl/type/FloatType.h"
+
+
+#define SAMPLE(path) (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/" path))
+
+
+void GlobalTypeAnalyzerTest::testAnalyzeTypes()
+{
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/callchain")));
+    QVERIFY(m_project.decodeBinaryFile());
+    QVERIFY(m_project.decompileBinaryFile());
+
+    Prog *prog     = m_project.getProg();
+    UserProc *main = static_cast<UserProc *>(prog->getFunctionByName("main"));
+    UserProc *add5 = static_cast<UserProc *>(prog->getFunctionByName("add5"));
+    QVERIFY(main != nullptr && add5 != nullptr);
+    QVERIFY(add5->getSignature()->getNumParams() > 0);
+
+    GlobalTypeAnalyzer analyzer(prog);
+
+    // everything is analyzed the first time
+    analyzer.analyzeTypes();
+    QVERIFY(analyzer.getNumAnalyzed(main) > 0);
+    QVERIFY(analyzer.getNumAnalyzed(add5) > 0);
+
+    // nothing changed
+    analyzer.analyzeTypes();
+    QCOMPARE(analyzer.getNumAnalyzed(main), 0);
+    QCOMPARE(analyzer.getNumAnalyzed(add5), 0);
+
+    // same type, but a different object
+    add5->setParamType(0, add5->getSignature()->getParamType(0)->clone());
+    analyzer.analyzeTypes();
+    QCOMPARE(analyzer.getNumAnalyzed(main), 0);
+    QCOMPARE(analyzer.getNumAnalyzed(add5), 0);
+
+    // changing a parameter type of add5 affects add5 and its caller
+    add5->setParamType(0, FloatType::get(64));
+    analyzer.analyzeTypes();
+    QVERIFY(analyzer.getNumAnalyzed(main) > 0);
+    QVERIFY(analyzer.getNumAnalyzed(add5) > 0);
+}
+
+
+QTEST_GUILESS_MAIN(GlobalTypeAnalyzerTest)
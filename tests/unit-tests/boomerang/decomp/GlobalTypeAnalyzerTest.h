@@ -0,0 +1,23 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class GlobalTypeAnalyzerTest : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that procedures are only re-analyzed when the types of a neighbour change
+    void testAnalyzeTypes();
+};
@@ -0,0 +1,170 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "AsyncLogWriterTest.h"
+
+
+#include "boomerang/util/log/AsyncLogWriter.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+static LogRecord makeRecord(int line, LogLevel level = LogLevel::Message)
+{
+    LogRecord record;
+    record.level = level;
+    record.file  = __FILE__;
+    record.line  = line;
+    record.msg   = QString::number(line);
+    return record;
+}
+
+
+void AsyncLogWriterTest::testWriteInOrder()
+{
+    std::vector<int> written;
+
+    AsyncLogWriter writer(
+        16, LogOverflowPolicy::Block,
+        [&written](const LogRecord &record) { written.push_back(record.line); }, []() {});
+
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(writer.push(makeRecord(i)));
+    }
+
+    writer.flush();
+
+    QCOMPARE(written.size(), std::size_t(1000));
+    for (int i = 0; i < 1000; ++i) {
+        QCOMPARE(written[i], i);
+    }
+
+    QCOMPARE(writer.getNumDropped(), std::size_t(0));
+}
+
+
+void AsyncLogWriterTest::testMultipleProducers()
+{
+    const int numThreads = 4;
+    const int numRecords = 10000;
+
+    std::vector<std::vector<int>> written(numThreads);
+
+    AsyncLogWriter writer(
+        64, LogOverflowPolicy::Block,
+        [&written](const LogRecord &record) {
+            written[record.msg.toInt()].push_back(record.line);
+        },
+        []() {});
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < numThreads; ++t) {
+        producers.emplace_back([&writer, t]() {
+            for (int i = 0; i < numRecords; ++i) {
+                LogRecord record = makeRecord(i);
+                record.msg       = QString::number(t);
+                writer.push(std::move(record));
+            }
+        });
+    }
+
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+
+    writer.flush();
+
+    // Records of each thread must be written in the order they were pushed
+    for (int t = 0; t < numThreads; ++t) {
+        QCOMPARE(written[t].size(), std::size_t(numRecords));
+
+        for (int i = 0; i < numRecords; ++i) {
+            QCOMPARE(written[t][i], i);
+        }
+    }
+}
+
+
+void AsyncLogWriterTest::testDrop()
+{
+    std::atomic<bool> blocked(true);
+    std::vector<LogRecord> written;
+
+    AsyncLogWriter writer(
+        4, LogOverflowPolicy::Drop,
+        [&written, &blocked](const LogRecord &record) {
+            while (blocked.load()) {
+                std::this_thread::yield();
+            }
+
+            written.push_back(record);
+        },
+        []() {});
+
+    // The writer blocks on the first record, so at most 4 + 1 records can be accepted
+    int numAccepted = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (writer.push(makeRecord(i))) {
+            numAccepted++;
+        }
+    }
+
+    QVERIFY(numAccepted <= 5);
+    QCOMPARE(writer.getNumDropped(), std::size_t(100 - numAccepted));
+
+    blocked.store(false);
+    writer.flush();
+
+    // all accepted records and a warning about the dropped ones
+    QCOMPARE(written.size(), std::size_t(numAccepted + 1));
+    for (int i = 0; i < numAccepted; ++i) {
+        QCOMPARE(written[i].line, i);
+    }
+
+    QVERIFY(written.back().level == LogLevel::Warning);
+    QVERIFY(written.back().msg.startsWith(QString::number(100 - numAccepted)));
+}
+
+
+void AsyncLogWriterTest::testFlush()
+{
+    int numWritten        = 0;
+    int numFlushes        = 0;
+    int numWrittenAtFlush = -1;
+
+    {
+        AsyncLogWriter writer(
+            16, LogOverflowPolicy::Block, [&numWritten](const LogRecord &) { numWritten++; },
+            [&]() {
+                numFlushes++;
+                numWrittenAtFlush = numWritten;
+            });
+
+        writer.flush();
+        QCOMPARE(numFlushes, 0); // nothing to flush
+
+        writer.push(makeRecord(__LINE__));
+        writer.push(makeRecord(__LINE__));
+        writer.flush();
+
+        QVERIFY(numFlushes >= 1);
+        QCOMPARE(numWrittenAtFlush, 2);
+
+        writer.push(makeRecord(__LINE__));
+    }
+
+    // Destroying the writer writes and flushes all queued records
+    QCOMPARE(numWritten, 3);
+    QCOMPARE(numWrittenAtFlush, 3);
+}
+
+
+QTEST_GUILESS_MAIN(AsyncLogWriterTest)
@@ -0,0 +1,110 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BytePatternTrieTest.h"
+
+
+#include "boomerang/util/BytePatternTrie.h"
+
+
+void BytePatternTrieTest::testAddPattern()
+{
+    BytePatternTrie trie;
+    QVERIFY(trie.isEmpty());
+
+    QVERIFY(!trie.addPattern("", "foo"));
+    QVERIFY(!trie.addPattern("5589E583EC08A1", "foo"));          // only 7 fixed bytes
+    QVERIFY(!trie.addPattern("5589E583EC08A1....", "foo"));      // wildcards do not count
+    QVERIFY(!trie.addPattern("5589E583EC08A1B", "foo"));         // odd number of digits
+    QVERIFY(!trie.addPattern("5589E583EC08A1XY", "foo"));        // not hexadecimal
+    QVERIFY(!trie.addPattern("5589E583EC08A1B2", ""));           // no name
+    QVERIFY(trie.isEmpty());
+
+    QVERIFY(trie.addPattern("5589E583EC08A1B2", "foo"));
+    QVERIFY(trie.addPattern("5589E5..EC08A1B2C3", "bar"));
+    QCOMPARE(trie.getNumPatterns(), std::size_t(2));
+    QCOMPARE(trie.getMaxPatternLength(), std::size_t(9));
+
+    trie.clear();
+    QVERIFY(trie.isEmpty());
+    QCOMPARE(trie.getMaxPatternLength(), std::size_t(0));
+}
+
+
+void BytePatternTrieTest::testMatch()
+{
+    BytePatternTrie trie;
+    QVERIFY(trie.addPattern("5589E583EC08A1B2", "foo"));
+
+    const Byte code[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xA1, 0xB2, 0x90 };
+    QCOMPARE(trie.match(code, sizeof(code)), QString("foo"));
+
+    // not enough bytes
+    QCOMPARE(trie.match(code, 7), QString());
+
+    const Byte otherCode[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x10, 0xA1, 0xB2 };
+    QCOMPARE(trie.match(otherCode, sizeof(otherCode)), QString());
+}
+
+
+void BytePatternTrieTest::testMatchWildcard()
+{
+    BytePatternTrie trie;
+    QVERIFY(trie.addPattern("5589E5E8........83C404C3", "foo"));
+
+    const Byte code1[] = { 0x55, 0x89, 0xE5, 0xE8, 0x10, 0x20, 0x30, 0x40, 0x83, 0xC4, 0x04, 0xC3 };
+    const Byte code2[] = { 0x55, 0x89, 0xE5, 0xE8, 0xFF, 0xFF, 0x00, 0x00, 0x83, 0xC4, 0x04, 0xC3 };
+    const Byte code3[] = { 0x55, 0x89, 0xE5, 0xE8, 0xFF, 0xFF, 0x00, 0x00, 0x83, 0xC4, 0x08, 0xC3 };
+
+    QCOMPARE(trie.match(code1, sizeof(code1)), QString("foo"));
+    QCOMPARE(trie.match(code2, sizeof(code2)), QString("foo"));
+    QCOMPARE(trie.match(code3, sizeof(code3)), QString());
+}
+
+
+void BytePatternTrieTest::testMatchLongest()
+{
+    BytePatternTrie trie;
+    QVERIFY(trie.addPattern("5589E583EC08A1B2", "short"));
+    QVERIFY(trie.addPattern("5589E583EC08A1B2..C3", "long"));
+    QVERIFY(trie.addPattern("5589E583EC08....C9C3", "wild"));
+
+    const Byte code1[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xA1, 0xB2, 0x00, 0xC3 };
+    const Byte code2[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xA1, 0xB2, 0x00, 0x90 };
+    const Byte code3[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0x00, 0x00, 0xC9, 0xC3 };
+
+    QCOMPARE(trie.match(code1, sizeof(code1)), QString("long"));
+    QCOMPARE(trie.match(code2, sizeof(code2)), QString("short"));
+    QCOMPARE(trie.match(code3, sizeof(code3)), QString("wild"));
+}
+
+
+void BytePatternTrieTest::testMatchAmbiguous()
+{
+    BytePatternTrie trie;
+
+    // identical patterns for different functions
+    QVERIFY(trie.addPattern("5589E583EC08A1B2", "foo"));
+    QVERIFY(trie.addPattern("5589E583EC08A1B2", "bar"));
+
+    const Byte code1[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xA1, 0xB2 };
+    QCOMPARE(trie.match(code1, sizeof(code1)), QString());
+
+    // different patterns of the same length matching the same bytes
+    QVERIFY(trie.addPattern("31C05DC3C9C3909090..", "baz"));
+    QVERIFY(trie.addPattern("31C05DC3C9C3....9090", "qux"));
+
+    const Byte code2[] = { 0x31, 0xC0, 0x5D, 0xC3, 0xC9, 0xC3, 0x90, 0x90, 0x90, 0x90 };
+    const Byte code3[] = { 0x31, 0xC0, 0x5D, 0xC3, 0xC9, 0xC3, 0x90, 0x90, 0x90, 0x00 };
+    QCOMPARE(trie.match(code2, sizeof(code2)), QString());
+    QCOMPARE(trie.match(code3, sizeof(code3)), QString("baz"));
+}
+
+
+QTEST_GUILESS_MAIN(BytePatternTrieTest)
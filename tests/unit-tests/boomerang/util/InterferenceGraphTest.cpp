@@ -0,0 +1,194 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "InterferenceGraphTest.h"
+
+
+#include "boomerang/util/InterferenceGraph.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/exp/Location.h"
+
+
+void InterferenceGraphTest::testInsertNode()
+{
+    SharedExp a = Terminal::get(opZF);
+    SharedExp b = Terminal::get(opCF);
+
+    InterferenceGraph ig;
+    QCOMPARE(ig.getNumNodes(), std::size_t(0));
+    QCOMPARE(ig.findNode(a), InterferenceGraph::NODE_INVALID);
+
+    const InterferenceGraph::NodeIndex idxA = ig.insertNode(a);
+    const InterferenceGraph::NodeIndex idxB = ig.insertNode(b);
+
+    QVERIFY(idxA != idxB);
+    QCOMPARE(ig.insertNode(Terminal::get(opZF)), idxA); // equal exp already exists
+    QCOMPARE(ig.findNode(b), idxB);
+    QCOMPARE(ig.getNumNodes(), std::size_t(2));
+    QVERIFY(*ig.getNode(idxA) == *a);
+}
+
+
+void InterferenceGraphTest::testAdd()
+{
+    SharedExp e1 = Terminal::get(opCF);
+    SharedExp e2 = Terminal::get(opZF);
+    SharedExp e3 = Terminal::get(opCF);
+
+    InterferenceGraph ig;
+    QVERIFY(ig.add(e1, e2));
+    QVERIFY(!ig.add(e1, e2)); // exact same exp already exists
+    QVERIFY(!ig.add(e2, e1)); // reverse already exists
+    QVERIFY(!ig.add(e2, e3)); // equal exp already exists
+}
+
+
+void InterferenceGraphTest::testConnect()
+{
+    SharedExp a = Terminal::get(opZF);
+    SharedExp b = Terminal::get(opCF);
+    SharedExp c = Terminal::get(opFZF);
+    SharedExp d = Terminal::get(opOF);
+
+    InterferenceGraph ig;
+
+    ig.add(a, b);
+    ig.add(c, d);
+
+    ig.connect(a, b);
+    QVERIFY(ig.isConnected(a, b));
+    QVERIFY(!ig.isConnected(a, c));
+    QVERIFY(!ig.isConnected(a, d));
+    QVERIFY(ig.isConnected(c, d));
+
+    ig.connect(a, c);
+    QVERIFY(ig.isConnected(a, c));
+    QVERIFY(ig.isConnected(a, b));
+    QVERIFY(ig.isConnected(a, d));
+    QVERIFY(ig.isConnected(c, b));
+    QVERIFY(ig.isConnected(c, d));
+    QVERIFY(!ig.isConnected(b, d));
+}
+
+
+void InterferenceGraphTest::testAddNeighbours()
+{
+    SharedExp a = Terminal::get(opZF);
+    SharedExp b = Terminal::get(opCF);
+    SharedExp c = Terminal::get(opFZF);
+    SharedExp d = Terminal::get(opOF);
+
+    InterferenceGraph ig;
+
+    ig.add(b, c);
+    ig.add(b, d);
+    ig.insertNode(a);
+
+    ig.addNeighbours(ig.findNode(a), ig.findNode(b));
+    QVERIFY(ig.isConnected(a, c));
+    QVERIFY(ig.isConnected(a, d));
+    QVERIFY(!ig.isConnected(a, b));
+    QVERIFY(!ig.isConnected(c, d));
+}
+
+
+void InterferenceGraphTest::testIsConnected()
+{
+    SharedExp a = Terminal::get(opZF);
+    SharedExp b = Terminal::get(opCF);
+    SharedExp c = Terminal::get(opFZF);
+
+    InterferenceGraph ig;
+
+    QVERIFY(!ig.isConnected(a, b));
+
+    ig.add(a, b);
+    ig.add(a, c);
+
+    QVERIFY(ig.isConnected(a, b));
+    QVERIFY(ig.isConnected(b, a));
+    QVERIFY(!ig.isConnected(b, c));
+    QVERIFY(!ig.isConnected(a, a));
+
+    ig.add(a, a);
+    QVERIFY(ig.isConnected(a, a));
+}
+
+
+void InterferenceGraphTest::testAllRefsHaveDefs()
+{
+    InterferenceGraph ig;
+    QVERIFY(ig.allRefsHaveDefs());
+
+    std::shared_ptr<Assign> asgn(new Assign(Location::regOf(REG_X86_ECX), Location::regOf(REG_X86_EAX)));
+    SharedExp ref1 = RefExp::get(Location::regOf(REG_X86_ECX), asgn);
+    ig.add(Location::regOf(REG_X86_ESI), ref1);
+
+    QVERIFY(ig.allRefsHaveDefs());
+
+    SharedExp ref2 = RefExp::get(Location::regOf(REG_X86_EBX), nullptr);
+    ig.add(ref2, Location::regOf(REG_X86_EDI));
+
+    QVERIFY(!ig.allRefsHaveDefs());
+}
+
+
+void InterferenceGraphTest::testSortedEdges()
+{
+    SharedExp a = Location::regOf(REG_X86_EAX);
+    SharedExp b = Location::regOf(REG_X86_ECX);
+    SharedExp c = Location::regOf(REG_X86_EDX);
+
+    InterferenceGraph ig;
+    ig.add(c, a);
+    ig.add(b, c);
+    ig.add(a, b);
+
+    const std::vector<std::pair<SharedExp, SharedExp>> edges = ig.getSortedEdges();
+    QCOMPARE(edges.size(), std::size_t(6));
+
+    QVERIFY(*edges[0].first == *a && *edges[0].second == *c);
+    QVERIFY(*edges[1].first == *a && *edges[1].second == *b);
+    QVERIFY(*edges[2].first == *b && *edges[2].second == *c);
+    QVERIFY(*edges[3].first == *b && *edges[3].second == *a);
+    QVERIFY(*edges[4].first == *c && *edges[4].second == *a);
+    QVERIFY(*edges[5].first == *c && *edges[5].second == *b);
+}
+
+
+void InterferenceGraphTest::testLargeGraph()
+{
+    const int numNodes = 5000;
+
+    InterferenceGraph ig;
+
+    for (int i = 0; i + 1 < numNodes; i += 2) {
+        QVERIFY(ig.add(Const::get(i), Const::get(i + 1)));
+    }
+
+    QCOMPARE(ig.getNumNodes(), std::size_t(numNodes));
+
+    for (int i = 0; i + 1 < numNodes; i += 2) {
+        QVERIFY(ig.isConnected(Const::get(i), Const::get(i + 1)));
+        QVERIFY(ig.isConnected(Const::get(i + 1), Const::get(i)));
+    }
+
+    QVERIFY(!ig.isConnected(Const::get(1), Const::get(2)));
+    QVERIFY(!ig.isConnected(Const::get(0), Const::get(numNodes - 1)));
+
+    QVERIFY(ig.add(Const::get(0), Const::get(numNodes - 1)));
+    QVERIFY(!ig.add(Const::get(numNodes - 1), Const::get(0)));
+    QVERIFY(ig.isConnected(Const::get(numNodes - 1), Const::get(0)));
+}
+
+
+QTEST_GUILESS_MAIN(InterferenceGraphTest)
@@ -13,15 +13,19 @@
 #include "TestUtils.h"
 
 
-class ConnectionGraphTest : public BoomerangTest
+class InterferenceGraphTest : public BoomerangTest
 {
     Q_OBJECT
 
 private slots:
+    void testInsertNode();
     void testAdd();
     void testConnect();
-    void testCount();
+    void testAddNeighbours();
     void testIsConnected();
     void testAllRefsHaveDefs();
-    void testUpdateConnection();
+    void testSortedEdges();
+
+    /// Test graphs that are too large for the adjacency matrix
+    void testLargeGraph();
 };
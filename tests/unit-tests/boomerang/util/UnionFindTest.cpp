@@ -0,0 +1,69 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "UnionFindTest.h"
+
+
+#include "boomerang/util/UnionFind.h"
+
+
+void UnionFindTest::testFind()
+{
+    UnionFind uf(4);
+    QCOMPARE(uf.size(), std::size_t(4));
+
+    for (std::size_t i = 0; i < uf.size(); ++i) {
+        QCOMPARE(uf.find(i), i);
+    }
+
+    QVERIFY(!uf.isSameSet(0, 1));
+}
+
+
+void UnionFindTest::testUnite()
+{
+    UnionFind uf(5);
+
+    QVERIFY(uf.unite(0, 1));
+    QVERIFY(uf.unite(2, 3));
+    QVERIFY(!uf.unite(1, 0)); // already in the same set
+
+    QVERIFY(uf.isSameSet(0, 1));
+    QVERIFY(uf.isSameSet(2, 3));
+    QVERIFY(!uf.isSameSet(1, 2));
+    QVERIFY(!uf.isSameSet(0, 4));
+
+    QVERIFY(uf.unite(1, 3));
+    QVERIFY(uf.isSameSet(0, 2));
+    QVERIFY(uf.isSameSet(0, 3));
+    QVERIFY(!uf.unite(0, 2));
+    QVERIFY(!uf.isSameSet(3, 4));
+}
+
+
+void UnionFindTest::testGrow()
+{
+    UnionFind uf;
+    QCOMPARE(uf.size(), std::size_t(0));
+
+    uf.grow(2);
+    QCOMPARE(uf.size(), std::size_t(2));
+    QVERIFY(uf.unite(0, 1));
+
+    uf.grow(1); // does not shrink
+    QCOMPARE(uf.size(), std::size_t(2));
+
+    uf.grow(3);
+    QCOMPARE(uf.size(), std::size_t(3));
+    QVERIFY(uf.isSameSet(0, 1));
+    QCOMPARE(uf.find(2), std::size_t(2));
+}
+
+
+QTEST_GUILESS_MAIN(UnionFindTest)